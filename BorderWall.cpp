@@ -2,6 +2,10 @@
 
 
 #include "Environment/BorderWall.h"
+#include "Environment/BorderWallRegistry.h"
+#include "Enemies/EnemyBase.h"
+#include "GameplaySnapshot.h"
+#include "GameplayHitchMonitor.h"
 
 // Sets default values
 ABorderWall::ABorderWall()
@@ -25,6 +29,19 @@ void ABorderWall::BeginPlay()
 
 	if (HealthComponent)
 		HealthComponent->OnDeath.AddDynamic(this, &ABorderWall::OnDeath);
+
+	if (UBorderWallRegistry* WallRegistry = UBorderWallRegistry::Get(GetWorld()))
+		WallRegistry->RegisterWall(this);
+
+	BuildAttackSlots();
+}
+
+void ABorderWall::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UBorderWallRegistry* WallRegistry = UBorderWallRegistry::Get(GetWorld()))
+		WallRegistry->RemoveWall(this);
+
+	Super::EndPlay(EndPlayReason);
 }
 
 // Called every frame
@@ -36,7 +53,21 @@ void ABorderWall::Tick(float DeltaTime)
 
 void ABorderWall::OnDeath()
 {
+	GAMEPLAY_HITCH_SCOPE(GetWorld(), "WallDeath");
+
 	GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Red, "Wall Destroyed!");
+
+	// Drop slot bookkeeping first so nothing gets promoted onto a dead wall
+	for (FAttackSlot& Slot : AttackSlots)
+	{
+		Slot.Occupant.Reset();
+	}
+	QueuedAttackers.Reset();
+
+	// Enemies on this wall get retargeted over the next few frames
+	if (UBorderWallRegistry* WallRegistry = UBorderWallRegistry::Get(GetWorld()))
+		WallRegistry->OnWallDestroyed(this);
+
 	OnDisabled();
 }
 
@@ -50,4 +81,167 @@ float ABorderWall::TakeDamage(float DamageAmount, FDamageEvent const& DamageEven
 	}
 
 	return DamageTaken;
+}
+
+void ABorderWall::SaveState(FBorderWallStateRecord& OutRecord) const
+{
+	OutRecord.Name = GetFName();
+	OutRecord.Health = HealthComponent ? HealthComponent->CurrentHealth : 0.f;
+}
+
+void ABorderWall::RestoreState(const FBorderWallStateRecord& Record)
+{
+	if (!HealthComponent)
+		return;
+
+	const bool bWasStanding = HealthComponent->CurrentHealth > 0.f;
+	HealthComponent->CurrentHealth = Record.Health;
+	HealthComponent->OnHealthChanged.Broadcast(HealthComponent->CurrentHealth, HealthComponent->CurrentMaxHealth);
+
+	if (bWasStanding && Record.Health <= 0.f)
+	{
+		OnDeath();
+	}
+	else if (!bWasStanding && Record.Health > 0.f)
+	{
+		if (UBorderWallRegistry* WallRegistry = UBorderWallRegistry::Get(GetWorld()))
+			WallRegistry->RegisterWall(this);
+
+		BuildAttackSlots();
+		OnRestored();
+	}
+}
+
+void ABorderWall::BuildAttackSlots()
+{
+	AttackSlots.Reset();
+
+	if (!WallMesh || !WallMesh->GetStaticMesh() || AttackSlotSpacing <= 0.f)
+		return;
+
+	const FBox LocalBox = WallMesh->GetStaticMesh()->GetBoundingBox();
+	const FTransform& WallTransform = WallMesh->GetComponentTransform();
+	const FVector Extent = LocalBox.GetExtent() * WallTransform.GetScale3D().GetAbs();
+	SlotCenter = WallTransform.TransformPosition(LocalBox.GetCenter());
+
+	// Slots run along the long horizontal axis, on both faces
+	const bool bAlongX = Extent.X >= Extent.Y;
+	const FVector LengthAxis = WallTransform.GetUnitAxis(bAlongX ? EAxis::X : EAxis::Y);
+	const FVector FaceAxis = WallTransform.GetUnitAxis(bAlongX ? EAxis::Y : EAxis::X);
+	const float HalfLength = bAlongX ? Extent.X : Extent.Y;
+	const float HalfThickness = bAlongX ? Extent.Y : Extent.X;
+
+	const int32 SlotsPerFace = FMath::Max(1, FMath::FloorToInt(2.f * HalfLength / AttackSlotSpacing));
+	const float Step = 2.f * HalfLength / SlotsPerFace;
+
+	AttackSlots.Reserve(SlotsPerFace * 2);
+	for (const float Side : { 1.f, -1.f })
+	{
+		const FVector FaceNormal = FaceAxis * Side;
+		for (int32 Index = 0; Index < SlotsPerFace; ++Index)
+		{
+			const float Offset = -HalfLength + Step * (Index + 0.5f);
+			AttackSlots.Add({ SlotCenter + LengthAxis * Offset + FaceNormal * (HalfThickness + AttackSlotStandoff), FaceNormal, nullptr });
+		}
+	}
+}
+
+bool ABorderWall::IsOnSide(const FAttackSlot& Slot, const FVector& Location) const
+{
+	return FVector::DotProduct(Location - SlotCenter, Slot.FaceNormal) >= 0.f;
+}
+
+int32 ABorderWall::ReserveAttackSlot(AEnemyBase* Enemy)
+{
+	if (!Enemy)
+		return INDEX_NONE;
+
+	const FVector EnemyLocation = Enemy->GetActorLocation();
+
+	int32 BestSlot = INDEX_NONE;
+	float BestDistanceSq = TNumericLimits<float>::Max();
+	for (int32 Index = 0; Index < AttackSlots.Num(); ++Index)
+	{
+		const FAttackSlot& Slot = AttackSlots[Index];
+		if (Slot.Occupant.IsValid() || !IsOnSide(Slot, EnemyLocation))
+			continue;
+
+		const float DistanceSq = FVector::DistSquared2D(EnemyLocation, Slot.Location);
+		if (DistanceSq < BestDistanceSq)
+		{
+			BestDistanceSq = DistanceSq;
+			BestSlot = Index;
+		}
+	}
+
+	if (BestSlot != INDEX_NONE)
+	{
+		AttackSlots[BestSlot].Occupant = Enemy;
+	}
+	else
+	{
+		QueuedAttackers.AddUnique(Enemy);
+	}
+
+	return BestSlot;
+}
+
+void ABorderWall::ReleaseAttackSlot(AEnemyBase* Enemy, int32 SlotIndex)
+{
+	QueuedAttackers.RemoveSingle(Enemy);
+
+	if (!AttackSlots.IsValidIndex(SlotIndex) || AttackSlots[SlotIndex].Occupant.Get() != Enemy)
+		return;
+
+	FAttackSlot& Slot = AttackSlots[SlotIndex];
+	Slot.Occupant.Reset();
+
+	// Hand the slot to the longest-waiting enemy on the same side
+	for (int32 Index = 0; Index < QueuedAttackers.Num(); ++Index)
+	{
+		AEnemyBase* Waiting = QueuedAttackers[Index].Get();
+		if (!Waiting)
+		{
+			QueuedAttackers.RemoveAt(Index--);
+			continue;
+		}
+
+		if (IsOnSide(Slot, Waiting->GetActorLocation()))
+		{
+			QueuedAttackers.RemoveAt(Index);
+			Slot.Occupant = Waiting;
+			Waiting->OnAttackSlotGranted(SlotIndex);
+			return;
+		}
+	}
+}
+
+FVector ABorderWall::GetQueueLocation(const AEnemyBase* Enemy) const
+{
+	if (!Enemy || AttackSlots.IsEmpty())
+		return GetActorLocation();
+
+	// Slots are laid out one face after the other
+	const int32 SlotsPerFace = AttackSlots.Num() / 2;
+	const FVector EnemyLocation = Enemy->GetActorLocation();
+	const int32 FaceStart = IsOnSide(AttackSlots[0], EnemyLocation) ? 0 : SlotsPerFace;
+
+	// Place among the enemies queued on the same face
+	int32 Position = 0;
+	for (const TWeakObjectPtr<AEnemyBase>& Queued : QueuedAttackers)
+	{
+		const AEnemyBase* Waiting = Queued.Get();
+		if (Waiting == Enemy)
+			break;
+
+		if (Waiting && IsOnSide(AttackSlots[FaceStart], Waiting->GetActorLocation()))
+		{
+			++Position;
+		}
+	}
+
+	// One spot behind each slot per row, further rows a slot spacing further out
+	const FAttackSlot& Slot = AttackSlots[FaceStart + Position % SlotsPerFace];
+	const int32 Row = Position / SlotsPerFace;
+	return Slot.Location + Slot.FaceNormal * (QueueRingOffset + Row * AttackSlotSpacing);
 }
\ No newline at end of file
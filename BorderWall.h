@@ -7,6 +7,9 @@
 #include "Components/HealthComponent.h"
 #include "BorderWall.generated.h"
 
+class AEnemyBase;
+struct FBorderWallStateRecord;
+
 UCLASS()
 class PROJECTSWAGGER_API ABorderWall : public AActor
 {
@@ -21,9 +24,15 @@ public:
 
 	float TakeDamage(float DamageAmount, FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser) override;
 
+	void SaveState(FBorderWallStateRecord& OutRecord) const;
+
+	// Can bring a fallen wall back, or knock a standing one down
+	void RestoreState(const FBorderWallStateRecord& Record);
+
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 		
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "Components")
 	TObjectPtr<UHealthComponent> HealthComponent;
@@ -31,6 +40,10 @@ protected:
 	UFUNCTION(BlueprintImplementableEvent, Category = "State")
 	void OnDisabled();
 
+	// Called when a snapshot restore brings a fallen wall back
+	UFUNCTION(BlueprintImplementableEvent, Category = "State")
+	void OnRestored();
+
 public:	
 	// Called every frame
 	virtual void Tick(float DeltaTime) override;
@@ -43,4 +56,44 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wall Properties")
 	float Health = 100.0f;
 
+	// Attack slots along both faces. Enemies without a slot wait in an outer ring.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Attack Slots")
+	float AttackSlotSpacing = 80.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Attack Slots", meta=(ToolTip="Distance in front of the wall face where attackers stand."))
+	float AttackSlotStandoff = 40.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Attack Slots", meta=(ToolTip="Distance beyond the slots where enemies wait for a free slot."))
+	float QueueRingOffset = 200.0f;
+
+	bool HasAttackSlots() const { return AttackSlots.Num() > 0; }
+
+	// Nearest free slot on the enemy's side of the wall. If none, the enemy is queued and INDEX_NONE is returned.
+	int32 ReserveAttackSlot(AEnemyBase* Enemy);
+
+	// Frees the slot (or the enemy's queue place) and hands it to the next queued enemy on that side
+	void ReleaseAttackSlot(AEnemyBase* Enemy, int32 SlotIndex);
+
+	FVector GetAttackSlotLocation(int32 SlotIndex) const { return AttackSlots.IsValidIndex(SlotIndex) ? AttackSlots[SlotIndex].Location : GetActorLocation(); }
+
+	// Waiting spot for a queued enemy. Spots fill rows along its face outside the slots, one per place in the queue.
+	FVector GetQueueLocation(const AEnemyBase* Enemy) const;
+
+private:
+	struct FAttackSlot
+	{
+		FVector Location;
+		FVector FaceNormal;
+		TWeakObjectPtr<AEnemyBase> Occupant;
+	};
+
+	void BuildAttackSlots();
+	bool IsOnSide(const FAttackSlot& Slot, const FVector& Location) const;
+
+	TArray<FAttackSlot> AttackSlots;
+
+	// FIFO of enemies waiting for a slot
+	TArray<TWeakObjectPtr<AEnemyBase>> QueuedAttackers;
+
+	FVector SlotCenter = FVector::ZeroVector;
 };
@@ -0,0 +1,235 @@
+#include "Environment/BorderWallRegistry.h"
+#include "Environment/BorderWall.h"
+#include "Enemies/EnemyBase.h"
+#include "Enemies/EnemyManager.h"
+#include "Enemies/WaveSpawner.h"
+#include "GameplayFrameArena.h"
+#include "GameplayMemoryTags.h"
+
+static TAutoConsoleVariable<int32> CVarWallRetargetBudget(
+	TEXT("Swagger.Walls.RetargetBudget"),
+	32,
+	TEXT("Max enemies retargeted per frame after a wall falls."));
+
+static TAutoConsoleVariable<float> CVarWallRegionSize(
+	TEXT("Swagger.Walls.RegionSize"),
+	500.f,
+	TEXT("Size of the region cells used to cache nearest-wall lookups."));
+
+UBorderWallRegistry* UBorderWallRegistry::Get(const UWorld* World)
+{
+	return World ? World->GetSubsystem<UBorderWallRegistry>() : nullptr;
+}
+
+TStatId UBorderWallRegistry::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UBorderWallRegistry, STATGROUP_Tickables);
+}
+
+void UBorderWallRegistry::RegisterWall(ABorderWall* Wall)
+{
+	LLM_SCOPE_BYTAG(Swagger_Registries);
+
+	if (IsValid(Wall) && !Walls.Contains(Wall))
+	{
+		Walls.Add(Wall);
+		AllWalls.AddUnique(Wall);
+		InvalidateCaches();
+	}
+}
+
+void UBorderWallRegistry::UnregisterWall(ABorderWall* Wall)
+{
+	if (Walls.RemoveSingleSwap(Wall, false) > 0)
+	{
+		InvalidateCaches();
+	}
+}
+
+void UBorderWallRegistry::RemoveWall(ABorderWall* Wall)
+{
+	UnregisterWall(Wall);
+	AllWalls.RemoveSingleSwap(Wall, false);
+}
+
+void UBorderWallRegistry::OnWallDestroyed(ABorderWall* Wall)
+{
+	UnregisterWall(Wall);
+
+	for (AEnemyBase* Enemy : AEnemyManager::GetAllEnemies(GetWorld()))
+	{
+		if (Enemy && Enemy->TargetWall == Wall)
+		{
+			Enemy->DestroyedWall();
+		}
+	}
+}
+
+void UBorderWallRegistry::QueueRetarget(AEnemyBase* Enemy)
+{
+	if (Enemy && !Enemy->bRetargetQueued)
+	{
+		Enemy->bRetargetQueued = true;
+		RetargetQueue.Add(Enemy);
+	}
+}
+
+void UBorderWallRegistry::Tick(float DeltaTime)
+{
+	GAMEPLAY_HEAP_SCOPE();
+
+	if (RetargetHead == RetargetQueue.Num())
+		return;
+
+	int32 Budget = FMath::Max(1, CVarWallRetargetBudget.GetValueOnGameThread());
+	while (Budget > 0 && RetargetHead < RetargetQueue.Num())
+	{
+		if (AEnemyBase* Enemy = RetargetQueue[RetargetHead].Get())
+		{
+			Enemy->bRetargetQueued = false;
+			Enemy->FindAndSetClosestWall();
+			--Budget;
+		}
+		++RetargetHead;
+	}
+
+	if (RetargetHead == RetargetQueue.Num())
+	{
+		RetargetQueue.Reset();
+		RetargetHead = 0;
+	}
+}
+
+ABorderWall* UBorderWallRegistry::FindNearestWall(const FVector& Location, FVector& OutPoint)
+{
+	const float RegionSize = GetRegionSize();
+	const FIntPoint Cell = GetRegionCell(Location, RegionSize);
+
+	TArray<TWeakObjectPtr<ABorderWall>, TInlineAllocator<4>>* Candidates = WallCandidatesByRegion.Find(Cell);
+	if (!Candidates)
+	{
+		LLM_SCOPE_BYTAG(Swagger_Registries);
+
+		Candidates = &WallCandidatesByRegion.Add(Cell);
+		GatherRegionCandidates(Cell, RegionSize, Location.Z, *Candidates);
+	}
+
+	// Final test from the actual location, so enemies near a boundary between walls still get the nearer one
+	float ClosestDistanceSq = TNumericLimits<float>::Max();
+	ABorderWall* ClosestWall = nullptr;
+	for (const TWeakObjectPtr<ABorderWall>& Candidate : *Candidates)
+	{
+		ABorderWall* Wall = Candidate.Get();
+		if (!IsValid(Wall))
+			continue;
+
+		const FVector Point = GetClosestPointOnWall(Wall, Location);
+		const float DistanceSq = FVector::DistSquared(Location, Point);
+		if (DistanceSq < ClosestDistanceSq)
+		{
+			ClosestDistanceSq = DistanceSq;
+			ClosestWall = Wall;
+			OutPoint = Point;
+		}
+	}
+
+	return ClosestWall;
+}
+
+void UBorderWallRegistry::GatherRegionCandidates(const FIntPoint& Cell, float RegionSize, float Z, TArray<TWeakObjectPtr<ABorderWall>, TInlineAllocator<4>>& OutCandidates) const
+{
+	const FVector CellCenter((Cell.X + 0.5f) * RegionSize, (Cell.Y + 0.5f) * RegionSize, Z);
+
+	TArray<float, TInlineAllocator<16>> Distances;
+	float NearestDistance = TNumericLimits<float>::Max();
+	for (ABorderWall* Wall : Walls)
+	{
+		const float Distance = IsValid(Wall) ? FVector::Dist2D(CellCenter, GetClosestPointOnWall(Wall, CellCenter)) : TNumericLimits<float>::Max();
+		Distances.Add(Distance);
+		NearestDistance = FMath::Min(NearestDistance, Distance);
+	}
+
+	// Anywhere in the cell is within half a diagonal of the center, so distances there differ from the
+	// center's by at most that much. A wall further than the nearest plus a full diagonal can't win.
+	const float Diagonal = RegionSize * UE_SQRT_2;
+	for (int32 Index = 0; Index < Walls.Num(); ++Index)
+	{
+		if (Distances[Index] <= NearestDistance + Diagonal)
+		{
+			OutCandidates.Add(Walls[Index].Get());
+		}
+	}
+}
+
+ABorderWall* UBorderWallRegistry::FindNearestWallToSpawner(const AWaveSpawner* Spawner)
+{
+	if (!Spawner)
+		return nullptr;
+
+	if (const TWeakObjectPtr<ABorderWall>* Cached = NearestWallBySpawner.Find(Spawner))
+	{
+		if (ABorderWall* Wall = Cached->Get())
+			return Wall;
+	}
+
+	ABorderWall* Wall = FindNearestWallUncached(Spawner->GetActorLocation());
+	NearestWallBySpawner.Add(Spawner, Wall);
+	return Wall;
+}
+
+ABorderWall* UBorderWallRegistry::FindNearestWallUncached(const FVector& Location) const
+{
+	float ClosestDistanceSq = TNumericLimits<float>::Max();
+	ABorderWall* ClosestWall = nullptr;
+
+	for (ABorderWall* Wall : Walls)
+	{
+		if (!IsValid(Wall))
+			continue;
+
+		const float DistanceSq = FVector::DistSquared(Location, GetClosestPointOnWall(Wall, Location));
+		if (DistanceSq < ClosestDistanceSq)
+		{
+			ClosestDistanceSq = DistanceSq;
+			ClosestWall = Wall;
+		}
+	}
+
+	return ClosestWall;
+}
+
+FVector UBorderWallRegistry::GetClosestPointOnWall(const ABorderWall* Wall, const FVector& Location)
+{
+	FVector PointOnWall = Wall->GetActorLocation(); // fallback
+	if (UPrimitiveComponent* WallRoot = Cast<UPrimitiveComponent>(Wall->GetRootComponent()))
+	{
+		FVector OutClosestPoint;
+		if (WallRoot->GetClosestPointOnCollision(Location, OutClosestPoint) >= 0.f)
+		{
+			PointOnWall = OutClosestPoint;
+		}
+	}
+	return PointOnWall;
+}
+
+float UBorderWallRegistry::GetRegionSize()
+{
+	const float RegionSize = FMath::Max(CVarWallRegionSize.GetValueOnGameThread(), 1.f);
+	if (RegionSize != CachedRegionSize)
+	{
+		CachedRegionSize = RegionSize;
+		WallCandidatesByRegion.Reset();
+	}
+	return RegionSize;
+}
+
+FIntPoint UBorderWallRegistry::GetRegionCell(const FVector& Location, float RegionSize) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / RegionSize), FMath::FloorToInt(Location.Y / RegionSize));
+}
+
+void UBorderWallRegistry::InvalidateCaches()
+{
+	WallCandidatesByRegion.Reset();
+	NearestWallBySpawner.Reset();
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "BorderWallRegistry.generated.h"
+
+class ABorderWall;
+class AEnemyBase;
+class AWaveSpawner;
+
+/**
+ * Live walls for a world, with the nearest wall cached per spawner and the
+ * candidate nearest walls cached per region cell. When a wall falls, affected enemies are retargeted over several
+ * frames under a budget instead of all at once.
+ */
+UCLASS()
+class PROJECTSWAGGER_API UBorderWallRegistry : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UBorderWallRegistry* Get(const UWorld* World);
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	void RegisterWall(ABorderWall* Wall);
+	void UnregisterWall(ABorderWall* Wall);
+
+	// Forgets the wall entirely, fallen or not. Called when it leaves play.
+	void RemoveWall(ABorderWall* Wall);
+
+	// Unregisters the wall and queues every enemy targeting it for retargeting
+	void OnWallDestroyed(ABorderWall* Wall);
+
+	void QueueRetarget(AEnemyBase* Enemy);
+
+	// Nearest live wall to Location. The region cache narrows the walls tested to the few that can be nearest in that cell. OutPoint is the closest point on that wall.
+	ABorderWall* FindNearestWall(const FVector& Location, FVector& OutPoint);
+
+	// Nearest live wall to a spawner, cached until a wall falls
+	ABorderWall* FindNearestWallToSpawner(const AWaveSpawner* Spawner);
+
+	TConstArrayView<TObjectPtr<ABorderWall>> GetWalls() const { return Walls; }
+
+	// Every wall in play, fallen ones included, e.g. for snapshots
+	TConstArrayView<TObjectPtr<ABorderWall>> GetAllWalls() const { return AllWalls; }
+
+	static FVector GetClosestPointOnWall(const ABorderWall* Wall, const FVector& Location);
+
+private:
+	ABorderWall* FindNearestWallUncached(const FVector& Location) const;
+
+	// Every wall that can be nearest to some point in the cell
+	void GatherRegionCandidates(const FIntPoint& Cell, float RegionSize, float Z, TArray<TWeakObjectPtr<ABorderWall>, TInlineAllocator<4>>& OutCandidates) const;
+
+	// Clamped region size. Changing the CVar drops the region cache.
+	float GetRegionSize();
+	FIntPoint GetRegionCell(const FVector& Location, float RegionSize) const;
+	void InvalidateCaches();
+
+	UPROPERTY()
+	TArray<TObjectPtr<ABorderWall>> Walls;
+
+	UPROPERTY()
+	TArray<TObjectPtr<ABorderWall>> AllWalls;
+
+	TMap<FIntPoint, TArray<TWeakObjectPtr<ABorderWall>, TInlineAllocator<4>>> WallCandidatesByRegion;
+	float CachedRegionSize = 0.f;
+	TMap<TWeakObjectPtr<const AWaveSpawner>, TWeakObjectPtr<ABorderWall>> NearestWallBySpawner;
+
+	// FIFO, consumed from RetargetHead
+	TArray<TWeakObjectPtr<AEnemyBase>> RetargetQueue;
+	int32 RetargetHead = 0;
+};
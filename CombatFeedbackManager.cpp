@@ -0,0 +1,183 @@
+#include "Enemies/CombatFeedbackManager.h"
+#include "Enemies/EnemyBase.h"
+#include "Environment/BorderWall.h"
+#include "NiagaraComponent.h"
+#include "NiagaraSystem.h"
+#include "AkGameplayStatics.h"
+#include "AkRtpc.h"
+#include "GameplayMemoryTags.h"
+
+DECLARE_STATS_GROUP(TEXT("CombatFeedback"), STATGROUP_CombatFeedback, STATCAT_Advanced);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Active Attack Effects"), STAT_CombatFeedback_Active, STATGROUP_CombatFeedback);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pooled Attack Effects"), STAT_CombatFeedback_Pooled, STATGROUP_CombatFeedback);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Merged Attacks"), STAT_CombatFeedback_Merged, STATGROUP_CombatFeedback);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Culled Attacks"), STAT_CombatFeedback_Culled, STATGROUP_CombatFeedback);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Crowd Intensity"), STAT_CombatFeedback_Intensity, STATGROUP_CombatFeedback);
+
+ACombatFeedbackManager* ACombatFeedbackManager::Instance = nullptr;
+
+ACombatFeedbackManager::ACombatFeedbackManager()
+{
+	PrimaryActorTick.bCanEverTick = true;
+
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+}
+
+ACombatFeedbackManager* ACombatFeedbackManager::Get(UWorld* World)
+{
+	return Instance && Instance->GetWorld() == World ? Instance : nullptr;
+}
+
+void ACombatFeedbackManager::BeginPlay()
+{
+	Super::BeginPlay();
+	Instance = this;
+
+	for (int32 Index = 0; Index < PrewarmPoolSize; ++Index)
+	{
+		if (UNiagaraComponent* Effect = CreateEffect())
+		{
+			EffectPool.Add(Effect);
+		}
+	}
+}
+
+void ACombatFeedbackManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (Instance == this)
+	{
+		Instance = nullptr;
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+UNiagaraComponent* ACombatFeedbackManager::AcquireEffect()
+{
+	return EffectPool.Num() > 0 ? EffectPool.Pop(false).Get() : CreateEffect();
+}
+
+UNiagaraComponent* ACombatFeedbackManager::CreateEffect()
+{
+	if (!AttackEffect)
+		return nullptr;
+
+	LLM_SCOPE_BYTAG(Swagger_Pools);
+
+	UNiagaraComponent* Effect = NewObject<UNiagaraComponent>(this);
+	Effect->SetAsset(AttackEffect);
+	Effect->SetAutoActivate(false);
+	Effect->SetAutoDestroy(false);
+	Effect->SetUsingAbsoluteLocation(true);
+	Effect->SetupAttachment(RootComponent);
+	Effect->OnSystemFinished.AddDynamic(this, &ACombatFeedbackManager::OnEffectFinished);
+	Effect->RegisterComponent();
+	return Effect;
+}
+
+void ACombatFeedbackManager::RequestAttackEffect(const AEnemyBase* Attacker, const ABorderWall* Wall, const FVector& Location)
+{
+	++AttacksThisFrame;
+
+	FWallEffectState& State = WallStates.FindOrAdd(Wall);
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	// Fold into the wall's most recent effect if it's still fresh
+	if (UNiagaraComponent* LastEffect = State.LastEffect.Get())
+	{
+		if (Now - State.LastEffectTime < MergeWindow)
+		{
+			LastEffect->SetVariableFloat(MergedCountParameter, ++State.LastEffectMergedCount);
+			INC_DWORD_STAT(STAT_CombatFeedback_Merged);
+			return;
+		}
+	}
+
+	if (ActiveEffects.Num() >= MaxConcurrentEffects || State.ActiveEffects >= MaxEffectsPerWall)
+	{
+		INC_DWORD_STAT(STAT_CombatFeedback_Culled);
+		return;
+	}
+
+	UNiagaraComponent* Effect = AcquireEffect();
+	if (!Effect)
+		return;
+
+	Effect->SetWorldLocation(Location);
+	Effect->SetVariableFloat(MergedCountParameter, 1.f);
+	Effect->Activate(true);
+
+	ActiveEffects.Add(Effect, Wall);
+	++State.ActiveEffects;
+	State.LastEffect = Effect;
+	State.LastEffectTime = Now;
+	State.LastEffectMergedCount = 1;
+}
+
+void ACombatFeedbackManager::OnEffectFinished(UNiagaraComponent* Effect)
+{
+	TWeakObjectPtr<const ABorderWall> Wall;
+	if (!ActiveEffects.RemoveAndCopyValue(Effect, Wall))
+		return;
+
+	if (FWallEffectState* State = WallStates.Find(Wall))
+	{
+		--State->ActiveEffects;
+		if (State->ActiveEffects <= 0 && !Wall.IsValid())
+		{
+			WallStates.Remove(Wall);
+		}
+	}
+
+	EffectPool.Add(Effect);
+}
+
+void ACombatFeedbackManager::PostWaveSpawnAudio(UAkAudioEvent* AudioEvent, AActor* Spawner)
+{
+	if (!AudioEvent || !Spawner)
+		return;
+
+	if (LastWaveAudioFrame != GFrameCounter)
+	{
+		LastWaveAudioFrame = GFrameCounter;
+		WaveAudioPostedThisFrame.Reset();
+	}
+
+	// Still one cue per area of the map, only spawners next to each other share one
+	const FVector Location = Spawner->GetActorLocation();
+	const float MergeRadiusSq = FMath::Square(WaveAudioMergeRadius);
+	for (const FPostedWaveAudio& Posted : WaveAudioPostedThisFrame)
+	{
+		if (Posted.Event == AudioEvent && FVector::DistSquared(Posted.Location, Location) <= MergeRadiusSq)
+			return;
+	}
+
+	WaveAudioPostedThisFrame.Add({ AudioEvent, Location });
+	UAkGameplayStatics::PostEvent(AudioEvent, Spawner, false, FOnAkPostEventCallback(), false);
+}
+
+void ACombatFeedbackManager::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	if (DeltaSeconds > 0.f)
+	{
+		const float Alpha = IntensitySmoothingTime > 0.f ? 1.f - FMath::Exp(-DeltaSeconds / IntensitySmoothingTime) : 1.f;
+		SmoothedAttacksPerSecond = FMath::Lerp(SmoothedAttacksPerSecond, AttacksThisFrame / DeltaSeconds, Alpha);
+	}
+	AttacksThisFrame = 0;
+
+	const float Intensity = AttacksPerSecondForFullIntensity > 0.f
+		? FMath::Clamp(SmoothedAttacksPerSecond / AttacksPerSecondForFullIntensity, 0.f, 1.f) : 0.f;
+
+	// One parameter update instead of an audio event per hit
+	if (CrowdIntensityRtpc && !FMath::IsNearlyEqual(Intensity, LastSentIntensity, 0.01f))
+	{
+		UAkGameplayStatics::SetRTPCValue(CrowdIntensityRtpc, Intensity * 100.f, 100, nullptr, NAME_None);
+		LastSentIntensity = Intensity;
+	}
+
+	SET_DWORD_STAT(STAT_CombatFeedback_Active, ActiveEffects.Num());
+	SET_DWORD_STAT(STAT_CombatFeedback_Pooled, EffectPool.Num());
+	SET_FLOAT_STAT(STAT_CombatFeedback_Intensity, Intensity);
+}
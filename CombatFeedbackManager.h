@@ -0,0 +1,107 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "CombatFeedbackManager.generated.h"
+
+class UNiagaraSystem;
+class UNiagaraComponent;
+class UAkAudioEvent;
+class UAkRtpc;
+class ABorderWall;
+class AEnemyBase;
+
+/**
+ * Pools attack effects and caps how many play per wall and in total. Attacks on the
+ * same wall within MergeWindow fold into one representative effect. Crowd audio is
+ * driven by a single intensity RTPC instead of per-hit events.
+ */
+UCLASS()
+class PROJECTSWAGGER_API ACombatFeedbackManager : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	ACombatFeedbackManager();
+
+	static ACombatFeedbackManager* Get(UWorld* World);
+
+	void RequestAttackEffect(const AEnemyBase* Attacker, const ABorderWall* Wall, const FVector& Location);
+
+	// Posts a wave spawn event on the spawner, unless the same event was already posted this frame on one within WaveAudioMergeRadius
+	void PostWaveSpawnAudio(UAkAudioEvent* AudioEvent, AActor* Spawner);
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VFX")
+	TObjectPtr<UNiagaraSystem> AttackEffect = nullptr;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VFX")
+	int32 MaxConcurrentEffects = 24;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VFX")
+	int32 MaxEffectsPerWall = 4;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VFX", meta=(ToolTip="Attacks on one wall within this many seconds share a single effect."))
+	float MergeWindow = 0.15f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VFX", meta=(ToolTip="Effect instances created up front."))
+	int32 PrewarmPoolSize = 8;
+
+	// Niagara float parameter set to the number of attacks an effect stands for
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VFX")
+	FName MergedCountParameter = "MergedCount";
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio")
+	TObjectPtr<UAkRtpc> CrowdIntensityRtpc = nullptr;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio", meta=(ToolTip="Attacks per second that map to full crowd intensity."))
+	float AttacksPerSecondForFullIntensity = 20.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio", meta=(ToolTip="Smoothing time for the crowd intensity, in seconds."))
+	float IntensitySmoothingTime = 0.5f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio", meta=(ToolTip="Spawners starting in the same frame closer than this share one wave spawn cue."))
+	float WaveAudioMergeRadius = 2000.0f;
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void Tick(float DeltaSeconds) override;
+
+private:
+	UNiagaraComponent* CreateEffect();
+	UNiagaraComponent* AcquireEffect();
+
+	UFUNCTION()
+	void OnEffectFinished(UNiagaraComponent* Effect);
+
+	struct FWallEffectState
+	{
+		int32 ActiveEffects = 0;
+		double LastEffectTime = -1.0;
+		TWeakObjectPtr<UNiagaraComponent> LastEffect;
+		int32 LastEffectMergedCount = 0;
+	};
+
+	UPROPERTY()
+	TArray<TObjectPtr<UNiagaraComponent>> EffectPool;
+
+	// Playing effects and the wall each one belongs to. Kept alive as owned components.
+	TMap<UNiagaraComponent*, TWeakObjectPtr<const ABorderWall>> ActiveEffects;
+
+	TMap<TWeakObjectPtr<const ABorderWall>, FWallEffectState> WallStates;
+
+	int32 AttacksThisFrame = 0;
+	float SmoothedAttacksPerSecond = 0.f;
+	float LastSentIntensity = -1.f;
+
+	struct FPostedWaveAudio
+	{
+		const UAkAudioEvent* Event;
+		FVector Location;
+	};
+
+	uint64 LastWaveAudioFrame = 0;
+	TArray<FPostedWaveAudio, TInlineAllocator<8>> WaveAudioPostedThisFrame;
+
+	static ACombatFeedbackManager* Instance;
+};
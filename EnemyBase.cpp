@@ -1,9 +1,20 @@
 #include "Enemies/EnemyBase.h"
 #include "Kismet/GameplayStatics.h"
+#include "Components/CapsuleComponent.h"
 #include "Components/StaticMeshComponent.h"
 #include "Components/WidgetComponent.h"
+#include "Engine/SkeletalMesh.h"
 #include "Enemies/EnemyManager.h"
-#include "GameEvents.h"
+#include "Enemies/CombatFeedbackManager.h"
+#include "Enemies/EnemyDamageSubsystem.h"
+#include "Enemies/EnemyDecisionSubsystem.h"
+#include "Enemies/EnemyProxySubsystem.h"
+#include "Enemies/EnemySimSubsystem.h"
+#include "Environment/BorderWallRegistry.h"
+#include "GameplayEventBus.h"
+#include "GameplaySnapshot.h"
+#include "GameplayFrameArena.h"
+#include "GameplayMemoryTags.h"
 #include "UI/ProgressBarWidget.h"
 #include "Engine/DamageEvents.h"
 #include "UI/ProjectSwaggerHUD.h"
@@ -11,21 +22,42 @@
 
 AEnemyBase::AEnemyBase()
 {
+	LLM_SCOPE_BYTAG(Swagger_Enemies);
+
 	PrimaryActorTick.bCanEverTick = true;
 
-	VisualMesh = CreateDefaultSubobject<USkeletalMeshComponent>(TEXT("VisualMesh"));
-	RootComponent = VisualMesh;
+	// Collision on its own root so the mesh can be drawn interpolated without moving it
+	CollisionComponent = CreateDefaultSubobject<UCapsuleComponent>(TEXT("CollisionComponent"));
+	CollisionComponent->InitCapsuleSize(40.f, 90.f);
+	RootComponent = CollisionComponent;
 	
-	VisualMesh->SetCollisionObjectType(ECC_Enemy);
+	CollisionComponent->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+	CollisionComponent->SetCollisionObjectType(ECC_Enemy);
 
 	// Ignore other enemies
-	VisualMesh->SetCollisionResponseToChannel(ECC_Enemy, ECollisionResponse::ECR_Ignore);
+	CollisionComponent->SetCollisionResponseToChannel(ECC_Enemy, ECollisionResponse::ECR_Ignore);
 
+	CollisionComponent->SetCollisionResponseToChannel(ECC_Pawn, ECollisionResponse::ECR_Block);
+	CollisionComponent->SetCollisionResponseToChannel(ECC_WorldStatic, ECollisionResponse::ECR_Block);
+	CollisionComponent->SetCollisionResponseToChannel(ECC_WorldDynamic, ECR_Overlap);
+	float RandomScale = FMath::FRandRange(0.4f, 0.8f);
+	CollisionComponent->SetWorldScale3D(FVector(RandomScale));
+
+	// Feet at the bottom of the capsule. Keeps the old root mesh's query responses so traces
+	// against the body still hit, but the capsule alone makes overlaps.
+	VisualMesh = CreateDefaultSubobject<USkeletalMeshComponent>(TEXT("VisualMesh"));
+	VisualMesh->SetupAttachment(CollisionComponent);
+	VisualMesh->SetRelativeLocation(FVector(0.f, 0.f, -CollisionComponent->GetUnscaledCapsuleHalfHeight()));
+	VisualMesh->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+	VisualMesh->SetCollisionObjectType(ECC_Enemy);
+	VisualMesh->SetCollisionResponseToChannel(ECC_Enemy, ECollisionResponse::ECR_Ignore);
 	VisualMesh->SetCollisionResponseToChannel(ECC_Pawn, ECollisionResponse::ECR_Block);
 	VisualMesh->SetCollisionResponseToChannel(ECC_WorldStatic, ECollisionResponse::ECR_Block);
 	VisualMesh->SetCollisionResponseToChannel(ECC_WorldDynamic, ECR_Overlap);
-	float RandomScale = FMath::FRandRange(0.4f, 0.8f);
-	VisualMesh->SetWorldScale3D(FVector(RandomScale));
+	VisualMesh->SetGenerateOverlapEvents(false);
+
+	// Spawners sit on the ground, so lift the capsule out of it
+	SpawnCollisionHandlingMethod = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
 
 	// Player Health Component
 	HealthComponent = CreateDefaultSubobject<UHealthComponent>(TEXT("HealthComponent"));
@@ -34,19 +66,102 @@ AEnemyBase::AEnemyBase()
 
 }
 
+void AEnemyBase::OnConstruction(const FTransform& Transform)
+{
+	Super::OnConstruction(Transform);
+
+	const USkeletalMesh* Mesh = VisualMesh->GetSkeletalMeshAsset();
+	if (!bFitCapsuleToMesh || !Mesh)
+		return;
+
+	// Bounds are in the mesh's space, so carry its relative scale over to the capsule's
+	const FBoxSphereBounds Bounds = Mesh->GetBounds();
+	const FVector MeshScale = VisualMesh->GetRelativeScale3D();
+	const FVector Extent = Bounds.BoxExtent * MeshScale;
+
+	// The narrower side, so arms and weapons don't push the capsule out
+	const float Radius = FMath::Max(FMath::Min(Extent.X, Extent.Y), 1.f);
+	const float HalfHeight = FMath::Max(Extent.Z, Radius);
+	CollisionComponent->SetCapsuleSize(Radius, HalfHeight);
+
+	const float MeshBottom = (Bounds.Origin.Z - Bounds.BoxExtent.Z) * MeshScale.Z;
+	FVector MeshLocation = VisualMesh->GetRelativeLocation();
+	MeshLocation.Z = -HalfHeight - MeshBottom;
+	VisualMesh->SetRelativeLocation(MeshLocation);
+}
+
 // Called when the game starts or when spawned
 void AEnemyBase::BeginPlay()
 {
+	LLM_SCOPE_BYTAG(Swagger_Enemies);
+
+	// Made here so the widget is counted on its own; the component's BeginPlay finds it already created
+	if (UWidgetComponent* Widget = FindComponentByClass<UWidgetComponent>())
+	{
+		LLM_SCOPE_BYTAG(Swagger_HealthBars);
+		Widget->InitWidget();
+	}
+
 	Super::BeginPlay();
-	FindAndSetClosestWall();
+
+	VisualMeshOffset = VisualMesh->GetRelativeLocation();
+
+	if (UEnemyDamageSubsystem* DamageSubsystem = UEnemyDamageSubsystem::Get(GetWorld()))
+	{
+		DamageSubsystem->RegisterEnemy(this);
+	}
+
+	// Stepped at the fixed sim rate from here on, with our own tick off unless a Blueprint Tick needs it
+	if (UEnemySimSubsystem* SimSubsystem = UEnemySimSubsystem::Get(GetWorld()))
+	{
+		SimSubsystem->RegisterEnemy(this);
+	}
+
+	// Fresh spawns take their spawner's precomputed wall
+	UBorderWallRegistry* WallRegistry = UBorderWallRegistry::Get(GetWorld());
+	if (ABorderWall* SpawnerWall = WallRegistry ? WallRegistry->FindNearestWallToSpawner(ParentSpawner) : nullptr)
+	{
+		TargetWall = SpawnerWall;
+		TargetPoint = UBorderWallRegistry::GetClosestPointOnWall(SpawnerWall, GetActorLocation());
+		ClaimAttackPosition();
+	}
+	else
+	{
+		FindAndSetClosestWall();
+	}
 }
 
 // Called every frame
 void AEnemyBase::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
-	
-	if (AProjectSwaggerHUD* GameHUD = Cast<AProjectSwaggerHUD>(GetWorld()->GetFirstPlayerController()->GetHUD()))
+
+	// Only still ticking under the fixed step simulation for the Blueprint Tick, which doesn't move us
+	if (SimSlot == INDEX_NONE)
+	{
+		SimulateStep(DeltaTime, true);
+	}
+}
+
+void AEnemyBase::SetMeshDrawOffset(const FVector& WorldOffset)
+{
+	const FVector Relative = VisualMeshOffset + GetActorTransform().InverseTransformVector(WorldOffset);
+	if (!VisualMesh->GetRelativeLocation().Equals(Relative, KINDA_SMALL_NUMBER))
+	{
+		VisualMesh->SetRelativeLocation(Relative);
+	}
+}
+
+bool AEnemyBase::HasBlueprintTick() const
+{
+	return GetClass()->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(AEnemyBase, ReceiveTick));
+}
+
+void AEnemyBase::SimulateStep(float DeltaTime, bool bUseDecision)
+{
+	// No player controller in headless runs
+	const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	if (AProjectSwaggerHUD* GameHUD = PlayerController ? Cast<AProjectSwaggerHUD>(PlayerController->GetHUD()) : nullptr)
 	{
 		if (GameHUD->IsInUI())
 		{
@@ -55,7 +170,48 @@ void AEnemyBase::Tick(float DeltaTime)
 		}
 	}
 	
-	MoveTowardTarget(DeltaTime);
+	GAMEPLAY_HEAP_SCOPE();
+
+	// Decided on worker threads before actors ticked; fall back if we weren't in the snapshot
+	const UEnemyDecisionSubsystem* DecisionSubsystem = bUseDecision ? UEnemyDecisionSubsystem::Get(GetWorld()) : nullptr;
+	const FEnemyDecisionResult* Decision = DecisionSubsystem ? DecisionSubsystem->GetDecision(this) : nullptr;
+	if (!Decision || !ApplyDecision(*Decision, DeltaTime))
+	{
+		MoveTowardTarget(DeltaTime);
+	}
+}
+
+bool AEnemyBase::ApplyDecision(const FEnemyDecisionResult& Decision, float DeltaTime)
+{
+	// Wall or slot changed earlier this frame
+	const bool bFixedTarget = AttackSlot != INDEX_NONE || bWaitingForSlot;
+	if (Decision.Wall != TargetWall || Decision.bFixedTarget != bFixedTarget)
+		return false;
+
+	switch (Decision.Action)
+	{
+	case EEnemyDecision::Move:
+		if (!bFixedTarget)
+		{
+			TargetPoint = Decision.TargetPoint;
+			GetWorld()->GetTimerManager().ClearTimer(DamageTimerHandle);
+		}
+		AddActorWorldOffset(Decision.Direction * FMath::Min(MoveSpeed * DeltaTime, Decision.Remaining), true);
+		break;
+
+	case EEnemyDecision::Attack:
+		if (!bFixedTarget)
+		{
+			TargetPoint = Decision.TargetPoint;
+		}
+		StartAttacking();
+		break;
+
+	default:
+		break;
+	}
+
+	return true;
 }
 
 void AEnemyBase::OnHealthChanged(float CurrentHealth, float CurrentMaxHealth)
@@ -73,6 +229,22 @@ void AEnemyBase::MoveTowardTarget(float DeltaTime)
 {
     if (!TargetWall) return;
 
+	// Slotted and queued enemies head for a fixed point, no collision query needed
+	if (AttackSlot != INDEX_NONE || bWaitingForSlot)
+	{
+		const FVector ToTarget(TargetPoint.X - GetActorLocation().X, TargetPoint.Y - GetActorLocation().Y, 0.f);
+		const float Distance = ToTarget.Size();
+		if (Distance > SlotArrivalTolerance)
+		{
+			AddActorWorldOffset(ToTarget.GetSafeNormal() * FMath::Min(MoveSpeed * DeltaTime, Distance), true);
+		}
+		else if (AttackSlot != INDEX_NONE)
+		{
+			StartAttacking();
+		}
+		return;
+	}
+
     FVector ClosestPoint;
 	float Distance = TargetWall->GetWallMesh()->GetClosestPointOnCollision(GetActorLocation(), ClosestPoint);
 	
@@ -87,35 +259,95 @@ void AEnemyBase::MoveTowardTarget(float DeltaTime)
             AddActorWorldOffset(Direction * MoveSpeed * DeltaTime, true);
         	GetWorld()->GetTimerManager().ClearTimer(DamageTimerHandle);
         }
-        else if (!bIsAttacking && DamageInterval > 0.f  && !GetWorld()->GetTimerManager().IsTimerActive(DamageTimerHandle))//fmath is nearly zero
+        else
         {
-        	bIsAttacking = true;
-        	GetWorld()->GetTimerManager().SetTimer(DamageTimerHandle, this, &AEnemyBase::Attack, DamageInterval, true);
+        	StartAttacking();
         }
     }
 }
 
+void AEnemyBase::StartAttacking()
+{
+	if (!bIsAttacking && DamageInterval > 0.f  && !GetWorld()->GetTimerManager().IsTimerActive(DamageTimerHandle))//fmath is nearly zero
+	{
+		// Attackers are always drawn in full
+		if (UEnemyProxySubsystem* ProxySubsystem = IsProxy() ? UEnemyProxySubsystem::Get(GetWorld()) : nullptr)
+		{
+			ProxySubsystem->ExitProxy(this);
+		}
+
+		bIsAttacking = true;
+		GetWorld()->GetTimerManager().SetTimer(DamageTimerHandle, this, &AEnemyBase::Attack, DamageInterval, true);
+	}
+}
+
+void AEnemyBase::ClaimAttackPosition()
+{
+	if (!TargetWall || !TargetWall->HasAttackSlots())
+		return;
+
+	AttackSlot = TargetWall->ReserveAttackSlot(this);
+	bWaitingForSlot = AttackSlot == INDEX_NONE;
+	TargetPoint = bWaitingForSlot ? TargetWall->GetQueueLocation(this) : TargetWall->GetAttackSlotLocation(AttackSlot);
+}
+
+void AEnemyBase::ReleaseAttackPosition()
+{
+	if (TargetWall && (AttackSlot != INDEX_NONE || bWaitingForSlot))
+	{
+		TargetWall->ReleaseAttackSlot(this, AttackSlot);
+	}
+
+	AttackSlot = INDEX_NONE;
+	bWaitingForSlot = false;
+}
+
+void AEnemyBase::OnAttackSlotGranted(int32 SlotIndex)
+{
+	AttackSlot = SlotIndex;
+	bWaitingForSlot = false;
+	if (TargetWall)
+	{
+		TargetPoint = TargetWall->GetAttackSlotLocation(SlotIndex);
+	}
+}
+
 void AEnemyBase::Attack() const
 {
 	if (!TargetWall) return;
 
-	AProjectSwaggerHUD* GameHUD = Cast<AProjectSwaggerHUD>(GetWorld()->GetFirstPlayerController()->GetHUD());
+	const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	const AProjectSwaggerHUD* GameHUD = PlayerController ? Cast<AProjectSwaggerHUD>(PlayerController->GetHUD()) : nullptr;
 
-	if (GameHUD->IsInUI())
+	if (GameHUD && GameHUD->IsInUI())
 	{
 		GEngine->AddOnScreenDebugMessage(-1,1.5f, FColor::Cyan, TEXT("Enemy can't attack because UI!"));
 		return;
 	}
 
-	float DistanceToWall = FVector::Dist(GetActorLocation(), TargetPoint);
+	// Slots sit at the wall's mid height, so only compare horizontally for slotted enemies
+	float DistanceToWall = AttackSlot != INDEX_NONE ? FVector::Dist2D(GetActorLocation(), TargetPoint) : FVector::Dist(GetActorLocation(), TargetPoint);
 
 	if (DistanceToWall <= AttackRange)
 	{
-		PlayAttackVFX();
+		// Pooled and merged per wall when a feedback manager is placed; Blueprint VFX otherwise
+		if (ACombatFeedbackManager* Feedback = ACombatFeedbackManager::Get(GetWorld()))
+		{
+			Feedback->RequestAttackEffect(this, TargetWall, TargetPoint);
+		}
+		else
+		{
+			PlayAttackVFX();
+		}
+		// A slot holds one attacker however many members the elite carries, so the wall takes no more than its slots allow
+		const float Damage = AttackDamage * (AttackSlot != INDEX_NONE ? 1 : EliteCount);
 		FDamageEvent DamageEvent;
-		TargetWall->TakeDamage(10.0f, DamageEvent, nullptr, const_cast<AActor*>(Cast<AActor>(this)));
+		TargetWall->TakeDamage(Damage, DamageEvent, nullptr, const_cast<AActor*>(Cast<AActor>(this)));
 
-		UGameEvents::OnEnemyAttack.Broadcast();
+		if (UGameplayEventBus* EventBus = UGameplayEventBus::Get(GetWorld()))
+		{
+			EventBus->Publish(FEnemyAttackEvent{ this, TargetWall, Damage });
+		}
 	}
 }
 
@@ -123,14 +355,36 @@ void AEnemyBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
 	Super::EndPlay(EndPlayReason);
 
+	ReleaseAttackPosition();
 	AEnemyManager::UnregisterEnemy(this);
+
+	if (UEnemyDamageSubsystem* DamageSubsystem = UEnemyDamageSubsystem::Get(GetWorld()))
+	{
+		DamageSubsystem->UnregisterEnemy(this);
+	}
+
+	if (UEnemyProxySubsystem* ProxySubsystem = UEnemyProxySubsystem::Get(GetWorld()))
+	{
+		ProxySubsystem->RemoveEnemy(this);
+	}
+
+	if (UEnemySimSubsystem* SimSubsystem = UEnemySimSubsystem::Get(GetWorld()))
+	{
+		SimSubsystem->UnregisterEnemy(this);
+	}
 }
 
 void AEnemyBase::DestroyedWall()
 {
 	GetWorld()->GetTimerManager().ClearTimer(DamageTimerHandle);
-	FindAndSetClosestWall();
+	ReleaseAttackPosition();
+	TargetWall = nullptr;
 	bIsAttacking = false;
+
+	if (UBorderWallRegistry* WallRegistry = UBorderWallRegistry::Get(GetWorld()))
+	{
+		WallRegistry->QueueRetarget(this);
+	}
 }
 
 void AEnemyBase::AdjustMaxHealth(float Value, bool IsAdding)
@@ -139,6 +393,11 @@ void AEnemyBase::AdjustMaxHealth(float Value, bool IsAdding)
 	{
 		GEngine->AddOnScreenDebugMessage(-1,1.5f, FColor::Cyan, FString::Printf(TEXT("Object: %s"), *(GetName())));
 		HealthComponent->AdjustMaxHealth(Value, IsAdding);
+
+		if (UEnemyDamageSubsystem* DamageSubsystem = UEnemyDamageSubsystem::Get(GetWorld()))
+		{
+			DamageSubsystem->SyncEnemy(this);
+		}
 	}
 }
 
@@ -148,6 +407,11 @@ void AEnemyBase::TempAdjustMaxHealth(float Value, bool IsAdding)
 	{
 		GEngine->AddOnScreenDebugMessage(-1,1.5f, FColor::Cyan, FString::Printf(TEXT("Object: %s"), *(GetName())));
 		HealthComponent->TempAdjustMaxHealth(Value, IsAdding);
+
+		if (UEnemyDamageSubsystem* DamageSubsystem = UEnemyDamageSubsystem::Get(GetWorld()))
+		{
+			DamageSubsystem->SyncEnemy(this);
+		}
 	}
 }
 
@@ -157,48 +421,173 @@ void AEnemyBase::ResetTempMaxHealth()
 	{
 		GEngine->AddOnScreenDebugMessage(-1,1.5f, FColor::Cyan, FString::Printf(TEXT("Object: %s"), *(GetName())));
 		HealthComponent->ResetTempMaxHealth();
+
+		if (UEnemyDamageSubsystem* DamageSubsystem = UEnemyDamageSubsystem::Get(GetWorld()))
+		{
+			DamageSubsystem->SyncEnemy(this);
+		}
 	}
 }
 
-void AEnemyBase::FindAndSetClosestWall()
+void AEnemyBase::SaveState(FEnemyStateRecord& OutRecord) const
+{
+	OutRecord.ClassPath = FSoftClassPath(GetClass()).ToString();
+	OutRecord.SpawnerName = ParentSpawner ? ParentSpawner->GetFName() : NAME_None;
+	OutRecord.Transform = GetActorTransform();
+	OutRecord.Transform.SetLocation(GetSimLocation());
+	OutRecord.Health = HealthComponent ? HealthComponent->CurrentHealth : 0.f;
+	OutRecord.MaxHealth = HealthComponent ? HealthComponent->MaxHealth : 0.f;
+	OutRecord.CurrentMaxHealth = HealthComponent ? HealthComponent->CurrentMaxHealth : 0.f;
+	OutRecord.EliteCount = EliteCount;
+}
+
+void AEnemyBase::RestoreState(const FEnemyStateRecord& Record, AWaveSpawner* Spawner)
 {
-	TArray<AActor*> FoundWalls;
-	UGameplayStatics::GetAllActorsOfClass(GetWorld(), ABorderWall::StaticClass(), FoundWalls);
+	ReleaseAttackPosition();
+	TargetWall = nullptr;
+	bIsAttacking = false;
+	GetWorldTimerManager().ClearTimer(DamageTimerHandle);
+
+	ParentSpawner = Spawner;
 
-	float ClosestDistanceSq = TNumericLimits<float>::Max();
-	ABorderWall* ClosestWall = nullptr;
-	FVector ClosestPoint = GetActorLocation();
+	// Reused enemies may have been an elite of a different size. The recorded scale already includes the elite's.
+	SetEliteCount(Record.EliteCount, true);
+	SetActorTransform(Record.Transform, false, nullptr, ETeleportType::TeleportPhysics);
+	SimLocation = PrevSimLocation = Record.Transform.GetLocation();
+	EliteBaseScale = IsElite() ? Record.Transform.GetScale3D() / GetEliteScaleFactor() : FVector::ZeroVector;
 
-	for (AActor* Actor : FoundWalls)
+	if (HealthComponent)
 	{
-		if (ABorderWall* Wall = Cast<ABorderWall>(Actor))
+		// After SetEliteCount, the recorded values already include the elite's share and any event buffs
+		HealthComponent->MaxHealth = Record.MaxHealth;
+		HealthComponent->CurrentMaxHealth = Record.CurrentMaxHealth;
+		HealthComponent->CurrentHealth = Record.Health;
+		if (UEnemyDamageSubsystem* DamageSubsystem = UEnemyDamageSubsystem::Get(GetWorld()))
 		{
-			FVector PointOnWall = Wall->GetActorLocation(); // fallback
-			if (UPrimitiveComponent* WallRoot = Cast<UPrimitiveComponent>(Wall->GetRootComponent()))
-			{
-				FVector OutClosestPoint;
-				if (WallRoot->GetClosestPointOnCollision(GetActorLocation(), OutClosestPoint))
-				{
-					PointOnWall = OutClosestPoint;
-				}
-			}
+			DamageSubsystem->SyncEnemy(this);
+		}
+		OnHealthChanged(HealthComponent->CurrentHealth, HealthComponent->CurrentMaxHealth);
+	}
+
+	FindAndSetClosestWall();
+}
+
+void AEnemyBase::AbsorbEnemy(AEnemyBase* Other)
+{
+	if (!Other || Other == this || !HealthComponent || !Other->HealthComponent)
+		return;
+
+	HealthComponent->MaxHealth += Other->HealthComponent->MaxHealth;
+	HealthComponent->CurrentMaxHealth += Other->HealthComponent->CurrentMaxHealth;
+	HealthComponent->CurrentHealth += Other->HealthComponent->CurrentHealth;
+
+	SetEliteCount(EliteCount + Other->EliteCount, false);
 
-			float DistanceSq = FVector::DistSquared(GetActorLocation(), PointOnWall);
-			if (DistanceSq < ClosestDistanceSq)
+	// EndPlay gives its attack slot to the next enemy in the queue
+	Other->Destroy();
+}
+
+void AEnemyBase::SplitElite()
+{
+	if (!IsElite() || !HealthComponent)
+		return;
+
+	LLM_SCOPE_BYTAG(Swagger_Enemies);
+
+	const int32 Members = EliteCount;
+	const float HealthShare = HealthComponent->CurrentHealth / Members;
+
+	HealthComponent->CurrentHealth = HealthShare;
+	SetEliteCount(1, true);
+
+	UEnemyDamageSubsystem* DamageSubsystem = UEnemyDamageSubsystem::Get(GetWorld());
+	for (int32 Member = 1; Member < Members; ++Member)
+	{
+		const FVector2D Offset = FMath::RandPointInCircle(100.f);
+		const FTransform SpawnTransform(GetActorRotation(), GetSimLocation() + FVector(Offset, 0.f));
+
+		AEnemyBase* Spawned = GetWorld()->SpawnActorDeferred<AEnemyBase>(GetClass(), SpawnTransform, nullptr, nullptr,
+			ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+		if (!Spawned)
+			continue;
+
+		Spawned->SetParentSpawner(ParentSpawner);
+		Spawned->FinishSpawning(SpawnTransform);
+		AEnemyManager::RegisterEnemy(Spawned);
+
+		if (Spawned->HealthComponent)
+		{
+			Spawned->HealthComponent->CurrentHealth = FMath::Min(HealthShare, Spawned->HealthComponent->CurrentMaxHealth);
+			if (DamageSubsystem)
 			{
-				ClosestDistanceSq = DistanceSq;
-				ClosestWall = Wall;
-				ClosestPoint = PointOnWall;
+				DamageSubsystem->SyncEnemy(Spawned);
 			}
+			Spawned->OnHealthChanged(Spawned->HealthComponent->CurrentHealth, Spawned->HealthComponent->CurrentMaxHealth);
+		}
+	}
+}
+
+void AEnemyBase::SetEliteCount(int32 NewCount, bool bRescaleHealth)
+{
+	NewCount = FMath::Max(NewCount, 1);
+
+	if (bRescaleHealth && HealthComponent && NewCount != EliteCount)
+	{
+		const float Ratio = float(NewCount) / EliteCount;
+		HealthComponent->MaxHealth *= Ratio;
+		HealthComponent->CurrentMaxHealth *= Ratio;
+		HealthComponent->CurrentHealth = FMath::Min(HealthComponent->CurrentHealth, HealthComponent->CurrentMaxHealth);
+	}
+
+	if (EliteCount == 1 && NewCount > 1)
+	{
+		EliteBaseScale = GetActorScale3D();
+	}
+
+	const bool bChanged = NewCount != EliteCount;
+	EliteCount = NewCount;
+
+	if (!EliteBaseScale.IsZero())
+	{
+		SetActorScale3D(EliteBaseScale * GetEliteScaleFactor());
+	}
+
+	if (HealthComponent)
+	{
+		if (UEnemyDamageSubsystem* DamageSubsystem = UEnemyDamageSubsystem::Get(GetWorld()))
+		{
+			DamageSubsystem->SyncEnemy(this);
 		}
+		OnHealthChanged(HealthComponent->CurrentHealth, HealthComponent->CurrentMaxHealth);
 	}
 
-	if (ClosestWall)
+	if (bChanged)
 	{
+		OnEliteChanged(EliteCount);
+	}
+}
+
+float AEnemyBase::GetEliteScaleFactor() const
+{
+	// Size follows volume, so it grows with the cube root of the member count
+	return FMath::Min(FMath::Pow(float(EliteCount), 1.f / 3.f), FMath::Max(EliteMaxScale, 1.f));
+}
+
+void AEnemyBase::FindAndSetClosestWall()
+{
+	UBorderWallRegistry* WallRegistry = UBorderWallRegistry::Get(GetWorld());
+	if (!WallRegistry)
+		return;
+
+	FVector ClosestPoint;
+	if (ABorderWall* ClosestWall = WallRegistry->FindNearestWall(GetActorLocation(), ClosestPoint))
+	{
+		ReleaseAttackPosition();
+
 		TargetWall = ClosestWall;
 		TargetPoint = ClosestPoint;
 
-		// Optionally: Move to TargetPoint
+		ClaimAttackPosition();
 	}
 }
 
@@ -209,17 +598,16 @@ float AEnemyBase::TakeDamage(float DamageAmount, FDamageEvent const& DamageEvent
 	float DamageTaken = Super::TakeDamage(DamageAmount, DamageEvent, EventInstigator, DamageCauser);
 	if (HealthComponent)
 	{
-		// Hit reaction
-		if (VisualMesh && HitReactMontage)
+		// Applied with the rest of the frame's damage; hit react and health events fire then
+		if (UEnemyDamageSubsystem* DamageSubsystem = UEnemyDamageSubsystem::Get(GetWorld()))
 		{
-			UAnimInstance* AnimInstance = VisualMesh->GetAnimInstance();
-			if (AnimInstance && !AnimInstance->Montage_IsPlaying(HitReactMontage))
-			{
-				AnimInstance->Montage_Play(HitReactMontage);
-			}
+			DamageSubsystem->QueueDamage(this, DamageTaken);
+		}
+		else
+		{
+			PlayHitReact();
+			HealthComponent->TakeDamage(DamageTaken);
 		}
-		
-		HealthComponent->TakeDamage(DamageTaken);
 	}
 
 	return DamageTaken;
@@ -227,10 +615,33 @@ float AEnemyBase::TakeDamage(float DamageAmount, FDamageEvent const& DamageEvent
 
 void AEnemyBase::ApplySimpleDamage(float DamageAmount, AActor* DamageCauser)
 {
+	// Through the engine chain so AnyDamage still fires; TakeDamage queues it for the batched pass
 	FDamageEvent DamageEvent; // Default generic damage event
 	TakeDamage(DamageAmount, DamageEvent, nullptr, DamageCauser);
 }
 
+void AEnemyBase::PlayHitReact()
+{
+	// Never loaded here; if the preload hasn't finished the hit just has no reaction
+	UAnimMontage* Montage = HitReactMontage.Get();
+	if (VisualMesh && Montage)
+	{
+		UAnimInstance* AnimInstance = VisualMesh->GetAnimInstance();
+		if (AnimInstance && !AnimInstance->Montage_IsPlaying(Montage))
+		{
+			AnimInstance->Montage_Play(Montage);
+		}
+	}
+}
+
+void AEnemyBase::GetPreloadAssets(TArray<FSoftObjectPath>& OutPaths) const
+{
+	if (!HitReactMontage.IsNull())
+	{
+		OutPaths.AddUnique(HitReactMontage.ToSoftObjectPath());
+	}
+}
+
 
 void AEnemyBase::OnDeath()
 {
@@ -7,12 +7,16 @@
 #include "Environment/BorderWall.h"
 #include "WaveSpawner.h"
 #include "Components/HealthComponent.h"
+#include "EnemyRegistry.h"
 #include "EnemyBase.generated.h"
 
 constexpr ECollisionChannel ECC_Enemy = ECollisionChannel::ECC_GameTraceChannel1;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnEnemyAttack);
 
+class UCapsuleComponent;
+struct FEnemyStateRecord;
+
 UCLASS(BlueprintType, Blueprintable)
 class PROJECTSWAGGER_API AEnemyBase : public AActor
 {
@@ -21,6 +25,15 @@ class PROJECTSWAGGER_API AEnemyBase : public AActor
 public:	
 	AEnemyBase();
 
+	// Root, blocks movement and makes the enemy's overlaps. Stays where the simulation has the enemy.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Collision")
+	TObjectPtr<UCapsuleComponent> CollisionComponent;
+
+	// Size the capsule from the mesh's bounds and stand the mesh on its bottom. Off keeps the capsule size and mesh placement set in the class.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Collision")
+	bool bFitCapsuleToMesh = true;
+
+	// Still answers traces and sweeps but makes no overlaps. Trails the root slightly while the fixed step simulation interpolates it.
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Skeletal Mesh")
 	TObjectPtr<USkeletalMeshComponent> VisualMesh;
 	
@@ -29,13 +42,24 @@ public:
 	bool bIsAttacking = false;
 	
 protected:
+	virtual void OnConstruction(const FTransform& Transform) override;
 	virtual void BeginPlay() override;
 
+	// Loaded with the enemy class before the first wave, see GetPreloadAssets
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Animation")
-	UAnimMontage* HitReactMontage;
+	TSoftObjectPtr<UAnimMontage> HitReactMontage;
 
 public:	
 	virtual void Tick(float DeltaTime) override;
+
+	// Soft assets the wave manager loads for this class before the first wave. Called on the class default object.
+	virtual void GetPreloadAssets(TArray<FSoftObjectPath>& OutPaths) const;
+
+	// One step of movement and attack logic. Decisions from this frame's parallel pass are only valid for the first step in a frame.
+	void SimulateStep(float DeltaTime, bool bUseDecision);
+
+	// Where the simulation has the enemy. The actor is kept there; only the mesh is drawn between the last two sim steps.
+	FVector GetSimLocation() const { return SimSlot != INDEX_NONE ? SimLocation : GetActorLocation(); }
 	
 	//Health Component
 	UFUNCTION()
@@ -50,10 +74,16 @@ public:
 	UFUNCTION()
 	void OnHealthChanged(float CurrentHealth, float CurrentMaxHealth);
 
+	// Drops the current wall and queues a budgeted retarget with the wall registry
 	void DestroyedWall();
 
 	void SetParentSpawner(AWaveSpawner* Spawner) { ParentSpawner = Spawner; }
 
+	void SaveState(FEnemyStateRecord& OutRecord) const;
+
+	// Moves the enemy into the recorded state and picks a wall from there
+	void RestoreState(const FEnemyStateRecord& Record, AWaveSpawner* Spawner);
+
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Basic")
@@ -67,9 +97,41 @@ public:
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
 	float DamageInterval = 3.0f;
+
+	// Damage per attack. Elites without an attack slot deal this once per merged member.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
+	float AttackDamage = 10.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat", meta=(ToolTip="How close to its wall attack slot the enemy must get before attacking."))
+	float SlotArrivalTolerance = 10.0f;
+
+	// Called by the target wall when a queued enemy is promoted to a free slot
+	void OnAttackSlotGranted(int32 SlotIndex);
 	
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "Stats")
 	UHealthComponent* HealthComponent;
+
+	// Drawn instanced in place of the skeletal mesh while far from the player. No proxy if empty.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Proxy")
+	TObjectPtr<UStaticMesh> ProxyMesh;
+
+	bool IsProxy() const { return ProxyInstance != INDEX_NONE; }
+
+	// How far an elite is scaled up at most, however many enemies it carries
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Elite", meta=(ClampMin=1.0))
+	float EliteMaxScale = 2.0f;
+
+	// Number of enemies merged into this one, 1 for a normal enemy
+	UFUNCTION(BlueprintPure, Category = "Elite")
+	int32 GetEliteCount() const { return EliteCount; }
+
+	bool IsElite() const { return EliteCount > 1; }
+
+	UFUNCTION(BlueprintImplementableEvent, Category = "Elite")
+	void OnEliteChanged(int32 NewEliteCount);
+
+	// Unset until registered. Hold this rather than a raw pointer and resolve it through the registry.
+	const FEnemyHandle& GetHandle() const { return RegistryHandle; }
 	
 	void AdjustMaxHealth(float Value, bool IsAdding);
 	void TempAdjustMaxHealth(float Value, bool IsAdding);
@@ -79,10 +141,69 @@ public:
 	UFUNCTION(BlueprintImplementableEvent, Category = "VFX")
 	void PlayAttackVFX() const;
 
+	// Plays the hit react montage unless it's already playing
+	void PlayHitReact();
+
 	
 private:
+	friend class UBorderWallRegistry;
+	friend class UEnemyDamageSubsystem;
+	friend class UEnemyDecisionSubsystem;
+	friend class UEnemyEliteSubsystem;
+	friend class UEnemyProxySubsystem;
+	friend class UEnemyRegistry;
+	friend class UEnemySimSubsystem;
+
+	FEnemyHandle RegistryHandle;
+
+	// Instance in the proxy subsystem's mesh for our class, INDEX_NONE while drawn in full
+	int32 ProxyInstance = INDEX_NONE;
+
+	// Slot in the damage subsystem's packed health arrays
+	int32 DamageSlot = INDEX_NONE;
+
+	// Output slot in this frame's decision phase
+	int32 DecisionSlot = INDEX_NONE;
+
+	// Bucket and slot in it in the fixed step simulation, INDEX_NONE while ticking normally
+	int32 SimBucket = INDEX_NONE;
+	int32 SimSlot = INDEX_NONE;
+	FVector SimLocation = FVector::ZeroVector;
+	FVector PrevSimLocation = FVector::ZeroVector;
+	uint64 SimStepFrame = 0;
+
+	// Mesh location relative to the root as set up in the class, before any interpolation offset
+	FVector VisualMeshOffset = FVector::ZeroVector;
+
+	// Draws the mesh this far from the root, in world space, without moving the actor or its collision
+	void SetMeshDrawOffset(const FVector& WorldOffset);
+
+	// Classes with a Blueprint Tick keep their actor tick while the simulation steps them
+	bool HasBlueprintTick() const;
+
+	int32 EliteCount = 1;
+
+	// Actor scale from before the first merge
+	FVector EliteBaseScale = FVector::ZeroVector;
+
+	// Adds Other's health and members to ours, then removes it from play
+	void AbsorbEnemy(AEnemyBase* Other);
+
+	// Spawns our members back out around us as normal enemies, sharing the health left
+	void SplitElite();
+
+	// Rescales max health with the member count when bRescaleHealth, and updates size and health listeners
+	void SetEliteCount(int32 NewCount, bool bRescaleHealth);
+
+	float GetEliteScaleFactor() const;
+
+	// Applies a result from the decision phase. Returns false if it no longer matches our state.
+	bool ApplyDecision(const struct FEnemyDecisionResult& Decision, float DeltaTime);
+
 	FTimerHandle DamageTimerHandle;
 
+	bool bRetargetQueued = false;
+
 	void FindAndSetClosestWall();
 
 	FVector TargetPoint;
@@ -95,4 +216,13 @@ private:
 
 	void MoveTowardTarget(float DeltaTime);
 
+	void StartAttacking();
+
+	// Reserve a slot on TargetWall, or a waiting spot if all slots on our side are taken
+	void ClaimAttackPosition();
+	void ReleaseAttackPosition();
+
+	int32 AttackSlot = INDEX_NONE;
+	bool bWaitingForSlot = false;
+
 };
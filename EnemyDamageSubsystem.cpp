@@ -0,0 +1,219 @@
+#include "Enemies/EnemyDamageSubsystem.h"
+#include "Enemies/EnemyBase.h"
+#include "Components/HealthComponent.h"
+#include "GameplayFrameArena.h"
+#include "GameplayMemoryTags.h"
+
+DECLARE_CYCLE_STAT(TEXT("Enemy Damage Pass"), STAT_EnemyDamagePass, STATGROUP_Game);
+DECLARE_CYCLE_STAT(TEXT("Enemy Damage Dispatch"), STAT_EnemyDamageDispatch, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Enemies Damaged"), STAT_EnemiesDamaged, STATGROUP_Game);
+
+UEnemyDamageSubsystem* UEnemyDamageSubsystem::Get(const UWorld* World)
+{
+	return World ? World->GetSubsystem<UEnemyDamageSubsystem>() : nullptr;
+}
+
+TStatId UEnemyDamageSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemyDamageSubsystem, STATGROUP_Tickables);
+}
+
+void UEnemyDamageSubsystem::Tick(float DeltaTime)
+{
+	Flush();
+}
+
+void UEnemyDamageSubsystem::RegisterEnemy(AEnemyBase* Enemy)
+{
+	LLM_SCOPE_BYTAG(Swagger_Registries);
+
+	if (!Enemy || Enemy->DamageSlot != INDEX_NONE)
+		return;
+
+	const int32 Slot = NumEnemies++;
+	if (Slot >= Health.Num())
+	{
+		// Grow by one vector of padding slots
+		Health.AddZeroed(4);
+		PendingDamage.AddZeroed(4);
+		Enemies.AddZeroed(4);
+
+		const int32 FirstPadding = MaxHealth.AddUninitialized(4);
+		for (int32 Padding = FirstPadding; Padding < MaxHealth.Num(); ++Padding)
+		{
+			MaxHealth[Padding] = 1.f;
+		}
+	}
+
+	Enemies[Slot] = Enemy;
+	Enemy->DamageSlot = Slot;
+	SyncEnemy(Enemy);
+}
+
+void UEnemyDamageSubsystem::UnregisterEnemy(AEnemyBase* Enemy)
+{
+	if (!Enemy || !Enemies.IsValidIndex(Enemy->DamageSlot) || Enemies[Enemy->DamageSlot] != Enemy)
+		return;
+
+	// Swap the last live slot into the hole so the live range stays dense
+	const int32 Slot = Enemy->DamageSlot;
+	const int32 Last = --NumEnemies;
+	if (Slot != Last)
+	{
+		Health[Slot] = Health[Last];
+		MaxHealth[Slot] = MaxHealth[Last];
+		PendingDamage[Slot] = PendingDamage[Last];
+		Enemies[Slot] = Enemies[Last];
+		Enemies[Slot]->DamageSlot = Slot;
+	}
+
+	Health[Last] = 0.f;
+	MaxHealth[Last] = 1.f;
+	PendingDamage[Last] = 0.f;
+	Enemies[Last] = nullptr;
+
+	Enemy->DamageSlot = INDEX_NONE;
+}
+
+void UEnemyDamageSubsystem::SyncEnemy(AEnemyBase* Enemy)
+{
+	if (!Enemy || !Enemies.IsValidIndex(Enemy->DamageSlot) || !Enemy->HealthComponent)
+		return;
+
+	const int32 Slot = Enemy->DamageSlot;
+	Health[Slot] = Enemy->HealthComponent->CurrentHealth;
+	MaxHealth[Slot] = Enemy->HealthComponent->CurrentMaxHealth;
+}
+
+void UEnemyDamageSubsystem::QueueDamage(AEnemyBase* Enemy, float DamageAmount)
+{
+	if (!Enemy || DamageAmount == 0.f)
+		return;
+
+	if (!Enemies.IsValidIndex(Enemy->DamageSlot))
+	{
+		// Not registered (not begun play yet), take it straight away
+		if (Enemy->HealthComponent)
+		{
+			Enemy->HealthComponent->TakeDamage(DamageAmount);
+		}
+		return;
+	}
+
+	PendingDamage[Enemy->DamageSlot] += DamageAmount;
+	bHasPendingDamage = true;
+}
+
+void UEnemyDamageSubsystem::ApplyDamageToEnemies(const TArray<AEnemyBase*>& InEnemies, float DamageAmount)
+{
+	for (AEnemyBase* Enemy : InEnemies)
+	{
+		QueueDamage(Enemy, DamageAmount);
+	}
+}
+
+void UEnemyDamageSubsystem::Flush()
+{
+	if (!bHasPendingDamage)
+		return;
+
+	bHasPendingDamage = false;
+
+	GAMEPLAY_HEAP_SCOPE();
+
+	ApplyPendingDamage();
+	DispatchResults();
+}
+
+void UEnemyDamageSubsystem::DiscardPending()
+{
+	FMemory::Memzero(PendingDamage.GetData(), PendingDamage.Num() * sizeof(float));
+	bHasPendingDamage = false;
+}
+
+void UEnemyDamageSubsystem::ApplyPendingDamage()
+{
+	SCOPE_CYCLE_COUNTER(STAT_EnemyDamagePass);
+
+	Results.Reset();
+
+	const VectorRegister4Float Zero = VectorZeroFloat();
+	const int32 NumPacked = Align(NumEnemies, 4);
+
+	float* HealthData = Health.GetData();
+	float* PendingData = PendingDamage.GetData();
+	const float* MaxHealthData = MaxHealth.GetData();
+
+	// Heals, Blueprints and restores write the component directly, so start every hit enemy from what it has now
+	for (int32 Slot = 0; Slot < NumEnemies; ++Slot)
+	{
+		if (PendingData[Slot] != 0.f)
+		{
+			SyncEnemy(Enemies[Slot]);
+		}
+	}
+
+	for (int32 Base = 0; Base < NumPacked; Base += 4)
+	{
+		const VectorRegister4Float Current = VectorLoadAligned(HealthData + Base);
+		const VectorRegister4Float Pending = VectorLoadAligned(PendingData + Base);
+		const VectorRegister4Float Max = VectorLoadAligned(MaxHealthData + Base);
+
+		const VectorRegister4Float New = VectorMin(VectorMax(VectorSubtract(Current, Pending), Zero), Max);
+
+		// Only living enemies with something pending count as hit
+		const int32 HitMask = VectorMaskBits(VectorBitwiseAnd(VectorCompareNE(Pending, Zero), VectorCompareGT(Current, Zero)));
+
+		if (HitMask)
+		{
+			const int32 DeathMask = HitMask & VectorMaskBits(VectorCompareLE(New, Zero));
+
+			alignas(16) float Previous[4];
+			VectorStoreAligned(Current, Previous);
+			VectorStoreAligned(New, HealthData + Base);
+
+			for (int32 Lane = 0; Lane < 4; ++Lane)
+			{
+				if (HitMask & (1 << Lane))
+				{
+					Results.Add({ Enemies[Base + Lane], Previous[Lane], HealthData[Base + Lane], (DeathMask & (1 << Lane)) != 0 });
+				}
+			}
+		}
+
+		VectorStoreAligned(Zero, PendingData + Base);
+	}
+
+	SET_DWORD_STAT(STAT_EnemiesDamaged, Results.Num());
+}
+
+void UEnemyDamageSubsystem::DispatchResults()
+{
+	SCOPE_CYCLE_COUNTER(STAT_EnemyDamageDispatch);
+
+	// Listeners may destroy enemies or queue more damage, which lands next frame
+	for (const FDamageResult& Result : Results)
+	{
+		AEnemyBase* Enemy = Result.Enemy;
+		if (!IsValid(Enemy) || !Enemy->HealthComponent)
+			continue;
+
+		if (Result.NewHealth < Result.PreviousHealth)
+		{
+			Enemy->PlayHitReact();
+		}
+
+		if (Result.bDied)
+		{
+			// Let the component take the killing blow so its own death handling runs
+			Enemy->HealthComponent->TakeDamage(Enemy->HealthComponent->CurrentHealth);
+		}
+		else
+		{
+			Enemy->HealthComponent->CurrentHealth = Result.NewHealth;
+			Enemy->HealthComponent->OnHealthChanged.Broadcast(Result.NewHealth, Enemy->HealthComponent->CurrentMaxHealth);
+		}
+	}
+
+	Results.Reset();
+}
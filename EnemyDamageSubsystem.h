@@ -0,0 +1,68 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemyDamageSubsystem.generated.h"
+
+class AEnemyBase;
+
+/**
+ * Queues enemy damage for the frame and applies it in one vectorized pass over
+ * packed health arrays after actors have ticked. Health changed, death and hit
+ * react are then dispatched once per damaged enemy, however many hits it took.
+ * The health component stays the owner of an enemy's health: the packed values
+ * of hit enemies are re-read from it before each pass.
+ */
+UCLASS()
+class PROJECTSWAGGER_API UEnemyDamageSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UEnemyDamageSubsystem* Get(const UWorld* World);
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	void RegisterEnemy(AEnemyBase* Enemy);
+	void UnregisterEnemy(AEnemyBase* Enemy);
+
+	// Re-reads the enemy's health component, e.g. after its max health changed
+	void SyncEnemy(AEnemyBase* Enemy);
+
+	// Negative amounts heal, clamped to max health
+	void QueueDamage(AEnemyBase* Enemy, float DamageAmount);
+
+	UFUNCTION(BlueprintCallable, Category = "Damage")
+	void ApplyDamageToEnemies(const TArray<AEnemyBase*>& Enemies, float DamageAmount);
+
+	// Applies everything queued so far and dispatches the results
+	void Flush();
+
+	// Drops everything queued so far without applying it
+	void DiscardPending();
+
+private:
+	struct FDamageResult
+	{
+		AEnemyBase* Enemy;
+		float PreviousHealth;
+		float NewHealth;
+		bool bDied;
+	};
+
+	void ApplyPendingDamage();
+	void DispatchResults();
+
+	// Packed per-slot data. Padded to a multiple of 4 so the pass needs no scalar tail.
+	TArray<float, TAlignedHeapAllocator<16>> Health;
+	TArray<float, TAlignedHeapAllocator<16>> MaxHealth;
+	TArray<float, TAlignedHeapAllocator<16>> PendingDamage;
+
+	TArray<AEnemyBase*> Enemies;
+	int32 NumEnemies = 0;
+
+	bool bHasPendingDamage = false;
+
+	TArray<FDamageResult> Results;
+};
@@ -0,0 +1,203 @@
+#include "Enemies/EnemyDecisionSubsystem.h"
+#include "Enemies/EnemyBase.h"
+#include "Enemies/EnemyManager.h"
+#include "Enemies/EnemySimSubsystem.h"
+#include "Environment/BorderWall.h"
+#include "Environment/BorderWallRegistry.h"
+#include "Async/ParallelFor.h"
+
+DECLARE_CYCLE_STAT(TEXT("Enemy Decision Snapshot"), STAT_EnemyDecisionSnapshot, STATGROUP_Game);
+DECLARE_CYCLE_STAT(TEXT("Enemy Decision Evaluate"), STAT_EnemyDecisionEvaluate, STATGROUP_Game);
+
+static TAutoConsoleVariable<bool> CVarParallelEnemyDecisions(
+	TEXT("Swagger.Enemies.ParallelDecisions"),
+	true,
+	TEXT("Evaluate enemy targeting on worker threads before actors tick. Off runs the old per-enemy path."));
+
+static TAutoConsoleVariable<int32> CVarEnemyDecisionBatchSize(
+	TEXT("Swagger.Enemies.DecisionBatchSize"),
+	64,
+	TEXT("Minimum enemies per worker batch in the decision phase."));
+
+UEnemyDecisionSubsystem* UEnemyDecisionSubsystem::Get(const UWorld* World)
+{
+	return World ? World->GetSubsystem<UEnemyDecisionSubsystem>() : nullptr;
+}
+
+void UEnemyDecisionSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	PreActorTickHandle = FWorldDelegates::OnWorldPreActorTick.AddUObject(this, &UEnemyDecisionSubsystem::OnWorldPreActorTick);
+}
+
+void UEnemyDecisionSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldPreActorTick.Remove(PreActorTickHandle);
+
+	Super::Deinitialize();
+}
+
+const FEnemyDecisionResult* UEnemyDecisionSubsystem::GetDecision(const AEnemyBase* Enemy) const
+{
+	const int32 Slot = Enemy->DecisionSlot;
+	return SnapshotEnemies.IsValidIndex(Slot) && SnapshotEnemies[Slot] == Enemy ? &Decisions[Slot] : nullptr;
+}
+
+void UEnemyDecisionSubsystem::OnWorldPreActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World != GetWorld())
+		return;
+
+	SnapshotEnemies.Reset();
+
+	if (!CVarParallelEnemyDecisions.GetValueOnGameThread() || TickType == LEVELTICK_ViewportsOnly)
+		return;
+
+	TakeSnapshot(World, DeltaSeconds);
+	EvaluateDecisions();
+}
+
+void UEnemyDecisionSubsystem::TakeSnapshot(UWorld* World, float DeltaSeconds)
+{
+	SCOPE_CYCLE_COUNTER(STAT_EnemyDecisionSnapshot);
+
+	WallSnapshots.Reset();
+	SnapshotWalls.Reset();
+	WallIndices.Reset();
+	if (const UBorderWallRegistry* WallRegistry = UBorderWallRegistry::Get(World))
+	{
+		for (const ABorderWall* Wall : WallRegistry->GetWalls())
+		{
+			const UStaticMeshComponent* WallMesh = Wall ? Wall->GetWallMesh() : nullptr;
+			if (!WallMesh || !WallMesh->GetStaticMesh())
+				continue;
+
+			WallSnapshots.Add({ WallMesh->GetComponentTransform(), WallMesh->GetStaticMesh()->GetBoundingBox() });
+			WallIndices.Add(Wall, SnapshotWalls.Add(Wall));
+		}
+	}
+
+	EnemySnapshots.Reset();
+
+	// Stepped enemies only use a decision on their first step in a frame, so only buckets stepping now need one
+	const UEnemySimSubsystem* SimSubsystem = UEnemySimSubsystem::Get(World);
+	if (SimSubsystem && SimSubsystem->IsEnabled())
+	{
+		const uint32 DueBuckets = SimSubsystem->GetDueBuckets(DeltaSeconds);
+		for (int32 Bucket = 0; Bucket < SimSubsystem->GetNumBuckets(); ++Bucket)
+		{
+			if (DueBuckets & (1u << Bucket))
+			{
+				for (AEnemyBase* Enemy : SimSubsystem->GetBucket(Bucket))
+				{
+					AddEnemySnapshot(Enemy, World);
+				}
+			}
+		}
+		return;
+	}
+
+	for (AEnemyBase* Enemy : AEnemyManager::GetAllEnemies(World))
+	{
+		AddEnemySnapshot(Enemy, World);
+	}
+}
+
+void UEnemyDecisionSubsystem::AddEnemySnapshot(AEnemyBase* Enemy, const UWorld* World)
+{
+	if (!IsValid(Enemy) || Enemy->GetWorld() != World || !Enemy->TargetWall)
+	{
+		if (Enemy)
+		{
+			Enemy->DecisionSlot = INDEX_NONE;
+		}
+		return;
+	}
+
+	const int32* WallIndex = WallIndices.Find(Enemy->TargetWall);
+	if (!WallIndex)
+	{
+		Enemy->DecisionSlot = INDEX_NONE;
+		return;
+	}
+
+	FEnemySnapshot& Snapshot = EnemySnapshots.AddUninitialized_GetRef();
+	Snapshot.Location = Enemy->GetSimLocation();
+	Snapshot.FixedTarget = Enemy->TargetPoint;
+	Snapshot.AttackRange = Enemy->AttackRange;
+	Snapshot.ArrivalTolerance = Enemy->SlotArrivalTolerance;
+	Snapshot.WallIndex = *WallIndex;
+	Snapshot.bHasSlot = Enemy->AttackSlot != INDEX_NONE;
+	Snapshot.bFixedTarget = Snapshot.bHasSlot || Enemy->bWaitingForSlot;
+
+	Enemy->DecisionSlot = SnapshotEnemies.Add(Enemy);
+}
+
+void UEnemyDecisionSubsystem::EvaluateDecisions()
+{
+	SCOPE_CYCLE_COUNTER(STAT_EnemyDecisionEvaluate);
+
+	Decisions.SetNum(EnemySnapshots.Num(), false);
+
+	// Workers only read the snapshots and write their own output slot
+	ParallelFor(TEXT("EnemyDecisions"), EnemySnapshots.Num(), FMath::Max(1, CVarEnemyDecisionBatchSize.GetValueOnGameThread()),
+		[this](int32 Index)
+		{
+			const FEnemySnapshot& Enemy = EnemySnapshots[Index];
+			FEnemyDecisionResult& Result = Decisions[Index];
+			Result.Wall = SnapshotWalls[Enemy.WallIndex];
+			Evaluate(Enemy, WallSnapshots[Enemy.WallIndex], Result);
+		});
+}
+
+void UEnemyDecisionSubsystem::Evaluate(const FEnemySnapshot& Enemy, const FWallSnapshot& Wall, FEnemyDecisionResult& OutResult)
+{
+	OutResult.bFixedTarget = Enemy.bFixedTarget;
+
+	// Slotted and queued enemies head for a fixed point
+	if (Enemy.bFixedTarget)
+	{
+		const FVector ToTarget(Enemy.FixedTarget.X - Enemy.Location.X, Enemy.FixedTarget.Y - Enemy.Location.Y, 0.f);
+		const float Distance = ToTarget.Size();
+
+		OutResult.TargetPoint = Enemy.FixedTarget;
+		OutResult.Remaining = Distance;
+
+		if (Distance > Enemy.ArrivalTolerance)
+		{
+			OutResult.Action = EEnemyDecision::Move;
+			OutResult.Direction = ToTarget / Distance;
+		}
+		else
+		{
+			OutResult.Action = Enemy.bHasSlot ? EEnemyDecision::Attack : EEnemyDecision::None;
+		}
+		return;
+	}
+
+	// Closest point on the wall's oriented box. Zero distance means inside, same as the collision query.
+	const FVector LocalLocation = Wall.ComponentTransform.InverseTransformPosition(Enemy.Location);
+	const FVector LocalClosest = LocalLocation.BoundToBox(Wall.LocalBounds.Min, Wall.LocalBounds.Max);
+	const FVector ClosestPoint = Wall.ComponentTransform.TransformPosition(LocalClosest);
+	const float Distance = FVector::Dist(Enemy.Location, ClosestPoint);
+
+	if (Distance <= 0.f)
+	{
+		OutResult.Action = EEnemyDecision::None;
+		return;
+	}
+
+	OutResult.TargetPoint = ClosestPoint;
+	OutResult.Remaining = TNumericLimits<float>::Max();
+
+	if (Distance > Enemy.AttackRange)
+	{
+		OutResult.Action = EEnemyDecision::Move;
+		OutResult.Direction = (ClosestPoint - Enemy.Location) / Distance;
+	}
+	else
+	{
+		OutResult.Action = EEnemyDecision::Attack;
+	}
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemyDecisionSubsystem.generated.h"
+
+class AEnemyBase;
+class ABorderWall;
+
+enum class EEnemyDecision : uint8
+{
+	None,
+	Move,
+	Attack
+};
+
+// Output slot for one enemy, written by a worker and applied in the enemy's tick
+struct FEnemyDecisionResult
+{
+	EEnemyDecision Action = EEnemyDecision::None;
+
+	// Wall the decision was made against, only compared, never dereferenced off the game thread
+	const ABorderWall* Wall = nullptr;
+
+	FVector TargetPoint = FVector::ZeroVector;
+	FVector Direction = FVector::ZeroVector;
+
+	// Distance left to the target. Movement is clamped to it for fixed targets.
+	float Remaining = 0.f;
+
+	bool bFixedTarget = false;
+};
+
+/**
+ * Runs the targeting and attack-range decisions before actors tick, for every enemy
+ * or, under the fixed step simulation, only those in buckets stepping this frame.
+ * Enemy and wall state is copied into plain snapshots, evaluated across worker
+ * threads, and each enemy applies its own result on the game thread when it steps.
+ * Walls are treated as oriented boxes from their mesh bounds so no physics query
+ * is needed on the workers.
+ */
+UCLASS()
+class PROJECTSWAGGER_API UEnemyDecisionSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UEnemyDecisionSubsystem* Get(const UWorld* World);
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// This frame's decision for the enemy, or null if it wasn't in the snapshot
+	const FEnemyDecisionResult* GetDecision(const AEnemyBase* Enemy) const;
+
+private:
+	struct FWallSnapshot
+	{
+		FTransform ComponentTransform;
+		FBox LocalBounds;
+	};
+
+	struct FEnemySnapshot
+	{
+		FVector Location;
+		FVector FixedTarget;
+		float AttackRange;
+		float ArrivalTolerance;
+		int32 WallIndex;
+		bool bFixedTarget;
+		bool bHasSlot;
+	};
+
+	void OnWorldPreActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+	void TakeSnapshot(UWorld* World, float DeltaSeconds);
+	void AddEnemySnapshot(AEnemyBase* Enemy, const UWorld* World);
+	void EvaluateDecisions();
+
+	static void Evaluate(const FEnemySnapshot& Enemy, const FWallSnapshot& Wall, FEnemyDecisionResult& OutResult);
+
+	TArray<FWallSnapshot> WallSnapshots;
+	TArray<const ABorderWall*> SnapshotWalls;
+
+	// Index of each wall in the snapshot, so enemies find theirs without a scan
+	TMap<const ABorderWall*, int32> WallIndices;
+
+	TArray<FEnemySnapshot> EnemySnapshots;
+	TArray<const AEnemyBase*> SnapshotEnemies;
+
+	TArray<FEnemyDecisionResult> Decisions;
+
+	FDelegateHandle PreActorTickHandle;
+};
@@ -0,0 +1,183 @@
+#include "Enemies/EnemyEliteSubsystem.h"
+#include "Enemies/EnemyBase.h"
+#include "Enemies/EnemyDamageSubsystem.h"
+#include "Enemies/EnemyManager.h"
+
+DECLARE_STATS_GROUP(TEXT("EnemyElites"), STATGROUP_EnemyElites, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Merge and Split"), STAT_EnemyEliteUpdate, STATGROUP_EnemyElites);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Elites"), STAT_EnemyElite_Elites, STATGROUP_EnemyElites);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Enemies in Elites"), STAT_EnemyElite_Merged, STATGROUP_EnemyElites);
+
+static TAutoConsoleVariable<bool> CVarEliteMerging(
+	TEXT("Swagger.Enemies.EliteMerging"),
+	false,
+	TEXT("Merge crowds of same-class enemies at a wall into elites. Turning it off splits existing elites back."));
+
+static TAutoConsoleVariable<int32> CVarEliteThreshold(
+	TEXT("Swagger.Enemies.EliteThreshold"),
+	40,
+	TEXT("Enemies targeting one wall above which they start merging."));
+
+static TAutoConsoleVariable<int32> CVarEliteMaxMembers(
+	TEXT("Swagger.Enemies.EliteMaxMembers"),
+	10,
+	TEXT("Most enemies one elite can carry."));
+
+static TAutoConsoleVariable<int32> CVarEliteBudget(
+	TEXT("Swagger.Enemies.EliteBudget"),
+	32,
+	TEXT("Max merges plus splits per check."));
+
+static TAutoConsoleVariable<float> CVarEliteCheckInterval(
+	TEXT("Swagger.Enemies.EliteCheckInterval"),
+	0.5f,
+	TEXT("Seconds between merge and split passes."));
+
+UEnemyEliteSubsystem* UEnemyEliteSubsystem::Get(const UWorld* World)
+{
+	return World ? World->GetSubsystem<UEnemyEliteSubsystem>() : nullptr;
+}
+
+TStatId UEnemyEliteSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemyEliteSubsystem, STATGROUP_Tickables);
+}
+
+void UEnemyEliteSubsystem::Tick(float DeltaTime)
+{
+	TimeSinceCheck += DeltaTime;
+	if (TimeSinceCheck < CVarEliteCheckInterval.GetValueOnGameThread())
+		return;
+
+	TimeSinceCheck = 0.0f;
+
+	const bool bEnabled = CVarEliteMerging.GetValueOnGameThread();
+	if (!bEnabled && NumElites == 0)
+		return;
+
+	SCOPE_CYCLE_COUNTER(STAT_EnemyEliteUpdate);
+
+	const int32 Threshold = FMath::Max(CVarEliteThreshold.GetValueOnGameThread(), 2);
+	const int32 MaxMembers = FMath::Max(CVarEliteMaxMembers.GetValueOnGameThread(), 2);
+	int32 Budget = CVarEliteBudget.GetValueOnGameThread();
+
+	// Health is merged and split as it stands, so apply this frame's hits first
+	if (UEnemyDamageSubsystem* DamageSubsystem = UEnemyDamageSubsystem::Get(GetWorld()))
+	{
+		DamageSubsystem->Flush();
+	}
+
+	// Copied out, merging and splitting change the registry
+	TMap<ABorderWall*, TArray<AEnemyBase*>> EnemiesByWall;
+	for (AEnemyBase* Enemy : AEnemyManager::GetAllEnemies(GetWorld()))
+	{
+		if (IsValid(Enemy) && Enemy->TargetWall)
+		{
+			EnemiesByWall.FindOrAdd(Enemy->TargetWall).Add(Enemy);
+		}
+	}
+
+	// Split only while the members fit a quarter under the threshold, so a wall doesn't flip between the two
+	const int32 SplitLimit = bEnabled ? Threshold * 3 / 4 : TNumericLimits<int32>::Max();
+
+	for (TPair<ABorderWall*, TArray<AEnemyBase*>>& Pair : EnemiesByWall)
+	{
+		if (Budget <= 0)
+			break;
+
+		TArray<AEnemyBase*>& WallEnemies = Pair.Value;
+		if (bEnabled && WallEnemies.Num() > Threshold)
+		{
+			Budget = MergeAtWall(WallEnemies, Threshold, MaxMembers, Budget);
+			continue;
+		}
+
+		int32 Entities = WallEnemies.Num();
+		for (AEnemyBase* Enemy : WallEnemies)
+		{
+			if (Budget <= 0)
+				break;
+
+			if (Enemy->IsElite() && Entities + Enemy->EliteCount - 1 <= SplitLimit)
+			{
+				Entities += Enemy->EliteCount - 1;
+				Enemy->SplitElite();
+				--Budget;
+			}
+		}
+	}
+
+	NumElites = 0;
+	NumMerged = 0;
+	for (const AEnemyBase* Enemy : AEnemyManager::GetAllEnemies(GetWorld()))
+	{
+		if (Enemy && Enemy->IsElite())
+		{
+			++NumElites;
+			NumMerged += Enemy->EliteCount;
+		}
+	}
+
+	SET_DWORD_STAT(STAT_EnemyElite_Elites, NumElites);
+	SET_DWORD_STAT(STAT_EnemyElite_Merged, NumMerged);
+}
+
+int32 UEnemyEliteSubsystem::MergeAtWall(TArray<AEnemyBase*>& WallEnemies, int32 Threshold, int32 MaxMembers, int32 Budget)
+{
+	int32 Entities = WallEnemies.Num();
+
+	// Only enemies already at the wall, attacking or queued for a slot, so nothing merges across the map
+	WallEnemies.RemoveAllSwap([](const AEnemyBase* Enemy)
+	{
+		return !Enemy->bIsAttacking && !Enemy->bWaitingForSlot;
+	}, false);
+
+	// Per class: elites with room first, then enemies holding a slot, so those become the anchors and queued enemies fold into them
+	auto Rank = [MaxMembers](const AEnemyBase& Enemy)
+	{
+		if (Enemy.IsElite())
+			return Enemy.EliteCount < MaxMembers ? 0 : 3;
+		return Enemy.AttackSlot != INDEX_NONE ? 1 : 2;
+	};
+
+	WallEnemies.Sort([&Rank](const AEnemyBase& A, const AEnemyBase& B)
+	{
+		if (A.GetClass() != B.GetClass())
+			return A.GetClass() < B.GetClass();
+		return Rank(A) < Rank(B);
+	});
+
+	int32 RunStart = 0;
+	while (RunStart < WallEnemies.Num() && Entities > Threshold && Budget > 0)
+	{
+		const UClass* RunClass = WallEnemies[RunStart]->GetClass();
+		int32 RunEnd = RunStart + 1;
+		while (RunEnd < WallEnemies.Num() && WallEnemies[RunEnd]->GetClass() == RunClass)
+		{
+			++RunEnd;
+		}
+
+		// Anchors from the front, absorbed enemies from the back
+		int32 Anchor = RunStart;
+		int32 Taken = RunEnd - 1;
+		while (Anchor < Taken && Entities > Threshold && Budget > 0)
+		{
+			AEnemyBase* Elite = WallEnemies[Anchor];
+			AEnemyBase* Other = WallEnemies[Taken];
+			if (Elite->EliteCount + Other->EliteCount > MaxMembers)
+			{
+				++Anchor;
+				continue;
+			}
+
+			Elite->AbsorbEnemy(Other);
+			--Taken;
+			--Entities;
+			--Budget;
+		}
+
+		RunStart = RunEnd;
+	}
+
+	return Budget;
+}
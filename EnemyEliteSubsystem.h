@@ -0,0 +1,39 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemyEliteSubsystem.generated.h"
+
+class AEnemyBase;
+class ABorderWall;
+
+/**
+ * Optional crowd aggregation. When too many enemies pile up on one wall, groups of
+ * same-class enemies at the wall merge into one elite that carries their combined
+ * health and is drawn larger. An elite in an attack slot still hits like one enemy,
+ * so merging never raises the damage a wall takes. Elites split back into normal enemies once
+ * the wall has room again, or when merging is turned off.
+ */
+UCLASS()
+class PROJECTSWAGGER_API UEnemyEliteSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UEnemyEliteSubsystem* Get(const UWorld* World);
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	int32 GetNumElites() const { return NumElites; }
+	int32 GetNumMerged() const { return NumMerged; }
+
+private:
+	// Merges at the wall until it's under the threshold. Returns the budget left.
+	int32 MergeAtWall(TArray<AEnemyBase*>& WallEnemies, int32 Threshold, int32 MaxMembers, int32 Budget);
+
+	float TimeSinceCheck = 0.0f;
+
+	int32 NumElites = 0;
+	int32 NumMerged = 0;
+};
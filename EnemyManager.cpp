@@ -1,13 +1,11 @@
 #include "Enemies/EnemyManager.h"
 #include "Enemies/EnemyBase.h"
+#include "Enemies/EnemyRegistry.h"
 #include "Kismet/GameplayStatics.h"
 #include "Interactables/Events/EventMgr.h"
 
 AEnemyManager* AEnemyManager::Instance = nullptr;
 
-
-TArray<AEnemyBase*> AEnemyManager::ActiveEnemies;
-
 AEnemyManager::AEnemyManager()
 {
 	PrimaryActorTick.bCanEverTick = false;
@@ -20,11 +18,23 @@ void AEnemyManager::BeginPlay()
 	Instance = this;
 }
 
+void AEnemyManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// Static outlives the world, don't carry it into the next session
+	if (Instance == this)
+	{
+		Instance = nullptr;
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void AEnemyManager::RegisterEnemy(AEnemyBase* Enemy)
 {
-	if (Enemy)
+	UEnemyRegistry* Registry = Enemy ? UEnemyRegistry::Get(Enemy->GetWorld()) : nullptr;
+	if (Registry)
 	{
-		ActiveEnemies.Add(Enemy);
+		Registry->RegisterEnemy(Enemy);
 
 		if (const AEventMgr* EventMgr = AEventMgr::Get())
 		{
@@ -36,37 +46,32 @@ void AEnemyManager::RegisterEnemy(AEnemyBase* Enemy)
 
 void AEnemyManager::UnregisterEnemy(AEnemyBase* Enemy)
 {
-	if (Enemy)
-		ActiveEnemies.RemoveSwap(Enemy);
+	if (UEnemyRegistry* Registry = Enemy ? UEnemyRegistry::Get(Enemy->GetWorld()) : nullptr)
+		Registry->UnregisterEnemy(Enemy);
 }
 
-const TArray<AEnemyBase*>& AEnemyManager::GetAllEnemies()
+TConstArrayView<TObjectPtr<AEnemyBase>> AEnemyManager::GetAllEnemies(const UWorld* World)
 {
-	return ActiveEnemies;
+	const UEnemyRegistry* Registry = UEnemyRegistry::Get(World);
+	return Registry ? Registry->GetEnemies() : TConstArrayView<TObjectPtr<AEnemyBase>>();
 }
 
 void AEnemyManager::TempAdjustMaxHealthForAll(float Value, bool IsAdding)
 {
-	for (AEnemyBase* Enemy : ActiveEnemies)
-	{
-		Enemy->TempAdjustMaxHealth(Value, IsAdding);
-	}
+	if (UEnemyRegistry* Registry = Instance ? UEnemyRegistry::Get(Instance->GetWorld()) : nullptr)
+		Registry->TempAdjustMaxHealthForAll(Value, IsAdding);
 }
 
 void AEnemyManager::AdjustMaxHealthForAll(float Value, bool IsAdding)
 {
-	for (AEnemyBase* Enemy : ActiveEnemies)
-	{
-		Enemy->AdjustMaxHealth(Value, IsAdding);
-	}
+	if (UEnemyRegistry* Registry = Instance ? UEnemyRegistry::Get(Instance->GetWorld()) : nullptr)
+		Registry->AdjustMaxHealthForAll(Value, IsAdding);
 }
 
 void AEnemyManager::ResetTempMaxHealthForAll()
 {
-	for (AEnemyBase* Enemy : ActiveEnemies)
-	{
-		Enemy->ResetTempMaxHealth();
-	}
+	if (UEnemyRegistry* Registry = Instance ? UEnemyRegistry::Get(Instance->GetWorld()) : nullptr)
+		Registry->ResetTempMaxHealthForAll();
 }
 
 AEnemyManager* AEnemyManager::Get(UWorld* World)
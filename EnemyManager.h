@@ -17,6 +17,7 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:	
 	UFUNCTION()
@@ -27,10 +28,10 @@ public:
 
 	static AEnemyManager* Get(UWorld* World);
 
-	UFUNCTION()
-	static const TArray<AEnemyBase*>& GetAllEnemies();
+	// Live enemies in the world's enemy registry
+	static TConstArrayView<TObjectPtr<AEnemyBase>> GetAllEnemies(const UWorld* World);
 
-	// Stats changes for every enemy
+	// Stats changes for every enemy. These route to the registry of the world this manager is in.
 	UFUNCTION()
 	static void TempAdjustMaxHealthForAll(float Value, bool IsAdding);
 	
@@ -42,8 +43,6 @@ public:
 
 private:
 
-	static TArray<AEnemyBase*> ActiveEnemies;
-
 	static AEnemyManager* Instance;
 	
 };
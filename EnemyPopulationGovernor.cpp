@@ -0,0 +1,99 @@
+#include "Enemies/EnemyPopulationGovernor.h"
+#include "RenderCore.h"
+
+DECLARE_STATS_GROUP(TEXT("Waves"), STATGROUP_Waves, STATCAT_Advanced);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Avg Game Thread (ms)"), STAT_Governor_AvgGameThreadMs, STATGROUP_Waves);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Enemy Cap"), STAT_Governor_EnemyCap, STATGROUP_Waves);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Spawn Rate Multiplier"), STAT_Governor_SpawnRate, STATGROUP_Waves);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Live Enemies"), STAT_Governor_LiveEnemies, STATGROUP_Waves);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Backlogged Spawns"), STAT_Governor_Backlog, STATGROUP_Waves);
+
+void FEnemyPopulationGovernor::Tick(const FPopulationGovernorSettings& Settings, float DeltaSeconds, int32 LiveEnemies)
+{
+	if (!Settings.bEnabled)
+	{
+		EnemyCap = TNumericLimits<int32>::Max();
+		SpawnRateMultiplier = 1.0f;
+		return;
+	}
+
+	// Game thread time of the last completed frame. Fall back to the frame delta if it isn't being measured.
+	float GameThreadMs = FPlatformTime::ToMilliseconds(GGameThreadTime);
+	if (GameThreadMs <= 0.0f)
+	{
+		GameThreadMs = DeltaSeconds * 1000.0f;
+	}
+
+	Samples.Add({ GameThreadMs, DeltaSeconds });
+	SampleMsSum += GameThreadMs;
+	SampleSeconds += DeltaSeconds;
+
+	while (Samples.Num() - OldestSample > 1 && SampleSeconds - Samples[OldestSample].DeltaSeconds >= Settings.WindowSeconds)
+	{
+		SampleMsSum -= Samples[OldestSample].GameThreadMs;
+		SampleSeconds -= Samples[OldestSample].DeltaSeconds;
+		++OldestSample;
+	}
+
+	// Compact occasionally instead of shifting on every frame
+	if (OldestSample > 256)
+	{
+		Samples.RemoveAt(0, OldestSample, EAllowShrinking::No);
+		OldestSample = 0;
+	}
+
+	TimeSinceAdjust += DeltaSeconds;
+	if (TimeSinceAdjust >= Settings.AdjustInterval)
+	{
+		TimeSinceAdjust = 0.0f;
+		Adjust(Settings, LiveEnemies);
+	}
+}
+
+void FEnemyPopulationGovernor::Adjust(const FPopulationGovernorSettings& Settings, int32 LiveEnemies)
+{
+	const float AverageMs = GetAverageGameThreadMs();
+	if (AverageMs <= 0.0f || Settings.TargetGameThreadMs <= 0.0f)
+		return;
+
+	if (EnemyCap == TNumericLimits<int32>::Max())
+	{
+		EnemyCap = Settings.MaxEnemyCap;
+	}
+
+	const float BudgetRatio = Settings.TargetGameThreadMs / AverageMs;
+
+	if (BudgetRatio < 1.0f)
+	{
+		// Over budget: scale the cap down from what's actually alive, not from the old cap
+		const int32 ScaledCap = FMath::FloorToInt(FMath::Min(EnemyCap, LiveEnemies) * BudgetRatio);
+		EnemyCap = FMath::Clamp(ScaledCap, Settings.MinEnemyCap, Settings.MaxEnemyCap);
+		SpawnRateMultiplier = FMath::Clamp(SpawnRateMultiplier * BudgetRatio, Settings.MinSpawnRateMultiplier, 1.0f);
+	}
+	else if (BudgetRatio > 1.15f)
+	{
+		// Comfortably under budget: recover slowly
+		EnemyCap = FMath::Clamp(EnemyCap + Settings.CapGrowthStep, Settings.MinEnemyCap, Settings.MaxEnemyCap);
+		SpawnRateMultiplier = FMath::Min(SpawnRateMultiplier + 0.1f, 1.0f);
+	}
+}
+
+bool FEnemyPopulationGovernor::CanSpawn(const FPopulationGovernorSettings& Settings, int32 LiveEnemies) const
+{
+	return !Settings.bEnabled || LiveEnemies < EnemyCap;
+}
+
+float FEnemyPopulationGovernor::GetAverageGameThreadMs() const
+{
+	const int32 NumSamples = Samples.Num() - OldestSample;
+	return NumSamples > 0 ? static_cast<float>(SampleMsSum / NumSamples) : 0.0f;
+}
+
+void FEnemyPopulationGovernor::PublishStats(const FPopulationGovernorStats& Stats)
+{
+	SET_FLOAT_STAT(STAT_Governor_AvgGameThreadMs, Stats.AverageGameThreadMs);
+	SET_DWORD_STAT(STAT_Governor_EnemyCap, Stats.EnemyCap);
+	SET_FLOAT_STAT(STAT_Governor_SpawnRate, Stats.SpawnRateMultiplier);
+	SET_DWORD_STAT(STAT_Governor_LiveEnemies, Stats.LiveEnemies);
+	SET_DWORD_STAT(STAT_Governor_Backlog, Stats.BackloggedSpawns);
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EnemyPopulationGovernor.generated.h"
+
+USTRUCT(BlueprintType)
+struct FPopulationGovernorSettings
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Governor")
+	bool bEnabled = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Governor", meta=(ToolTip="Game thread time per frame the governor tries to stay under, in milliseconds."))
+	float TargetGameThreadMs = 12.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Governor", meta=(ToolTip="Length of the rolling frame time window, in seconds."))
+	float WindowSeconds = 2.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Governor", meta=(ToolTip="How often the cap and spawn rate are re-evaluated, in seconds."))
+	float AdjustInterval = 0.5f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Governor")
+	int32 MinEnemyCap = 20;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Governor")
+	int32 MaxEnemyCap = 400;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Governor", meta=(ToolTip="How many enemies the cap grows by per adjustment while under budget."))
+	int32 CapGrowthStep = 10;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Governor", meta=(ClampMin=0.05, ClampMax=1.0))
+	float MinSpawnRateMultiplier = 0.25f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Governor", meta=(ToolTip="Backlogged spawns released per second at full spawn rate."))
+	float BacklogSpawnsPerSecond = 4.0f;
+};
+
+USTRUCT(BlueprintType)
+struct FPopulationGovernorStats
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Governor")
+	float AverageGameThreadMs = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Governor")
+	int32 EnemyCap = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Governor")
+	float SpawnRateMultiplier = 1.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Governor")
+	int32 LiveEnemies = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Governor")
+	int32 BackloggedSpawns = 0;
+};
+
+/**
+ * Tracks game thread frame time over a rolling window and adjusts a live enemy cap
+ * and spawn rate multiplier to hold a frame budget. Decrease is multiplicative,
+ * growth is additive, so it backs off quickly and recovers slowly.
+ */
+class PROJECTSWAGGER_API FEnemyPopulationGovernor
+{
+public:
+	void Tick(const FPopulationGovernorSettings& Settings, float DeltaSeconds, int32 LiveEnemies);
+
+	bool CanSpawn(const FPopulationGovernorSettings& Settings, int32 LiveEnemies) const;
+
+	int32 GetEnemyCap() const { return EnemyCap; }
+	float GetSpawnRateMultiplier() const { return SpawnRateMultiplier; }
+	float GetAverageGameThreadMs() const;
+
+	// Pushes the governor's decisions to the "stat Waves" group
+	static void PublishStats(const FPopulationGovernorStats& Stats);
+
+private:
+	struct FFrameSample
+	{
+		float GameThreadMs;
+		float DeltaSeconds;
+	};
+
+	void Adjust(const FPopulationGovernorSettings& Settings, int32 LiveEnemies);
+
+	TArray<FFrameSample> Samples;
+	int32 OldestSample = 0;
+	double SampleMsSum = 0.0;
+	double SampleSeconds = 0.0;
+
+	float TimeSinceAdjust = 0.0f;
+	int32 EnemyCap = TNumericLimits<int32>::Max();
+	float SpawnRateMultiplier = 1.0f;
+};
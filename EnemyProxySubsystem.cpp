@@ -0,0 +1,305 @@
+#include "Enemies/EnemyProxySubsystem.h"
+#include "Enemies/EnemyBase.h"
+#include "Enemies/EnemyManager.h"
+#include "Enemies/WaveSpawner.h"
+#include "GameplayActorRegistry.h"
+#include "ProjectSwagger/ProjectSwaggerCharacter.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Kismet/GameplayStatics.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogEnemyProxy, Log, All);
+
+DECLARE_STATS_GROUP(TEXT("EnemyProxies"), STATGROUP_EnemyProxies, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Proxy Update"), STAT_EnemyProxyUpdate, STATGROUP_EnemyProxies);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Full Enemies"), STAT_EnemyProxy_Full, STATGROUP_EnemyProxies);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Proxy Enemies"), STAT_EnemyProxy_Proxies, STATGROUP_EnemyProxies);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Tier Switches"), STAT_EnemyProxy_Switches, STATGROUP_EnemyProxies);
+
+static TAutoConsoleVariable<bool> CVarEnemyProxiesEnabled(
+	TEXT("Swagger.Enemies.Proxies"),
+	true,
+	TEXT("Draw distant walking enemies as instanced static mesh proxies."));
+
+static TAutoConsoleVariable<float> CVarEnemyProxyDistance(
+	TEXT("Swagger.Enemies.ProxyDistance"),
+	3000.f,
+	TEXT("Distance from the player beyond which walking enemies become proxies."));
+
+static TAutoConsoleVariable<float> CVarEnemyProxyHysteresis(
+	TEXT("Swagger.Enemies.ProxyHysteresis"),
+	300.f,
+	TEXT("How much closer than the proxy distance an enemy must come before it switches back."));
+
+static TAutoConsoleVariable<FString> CVarEnemyProxyViewPoint(
+	TEXT("Swagger.Enemies.ProxyViewPoint"),
+	TEXT(""),
+	TEXT("Distances are measured from here when there is no player, e.g. \"X=0 Y=0 Z=0\". Empty uses the middle of the spawners."));
+
+static TAutoConsoleVariable<int32> CVarEnemyProxySwitchBudget(
+	TEXT("Swagger.Enemies.ProxySwitchBudget"),
+	16,
+	TEXT("Max enemies switched into proxy mode per frame. Switching back is never deferred."));
+
+static FAutoConsoleCommandWithWorld GEnemyProxyReportCommand(
+	TEXT("Swagger.Enemies.ProxyReport"),
+	TEXT("Logs full and proxy enemy counts and their estimated memory."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const UEnemyProxySubsystem* Proxies = UEnemyProxySubsystem::Get(World))
+		{
+			Proxies->Report();
+		}
+	}));
+
+UEnemyProxySubsystem* UEnemyProxySubsystem::Get(const UWorld* World)
+{
+	return World ? World->GetSubsystem<UEnemyProxySubsystem>() : nullptr;
+}
+
+TStatId UEnemyProxySubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemyProxySubsystem, STATGROUP_Tickables);
+}
+
+void UEnemyProxySubsystem::Deinitialize()
+{
+	ProxyClasses.Reset();
+	ProxyHost = nullptr;
+	NumProxies = 0;
+
+	Super::Deinitialize();
+}
+
+bool UEnemyProxySubsystem::GetViewLocation(FVector& OutLocation) const
+{
+	const UGameplayActorRegistry* ActorRegistry = UGameplayActorRegistry::Get(GetWorld());
+	const AActor* Player = ActorRegistry ? ActorRegistry->GetPlayer() : nullptr;
+	if (!Player)
+	{
+		Player = UGameplayStatics::GetPlayerPawn(GetWorld(), 0);
+	}
+
+	if (Player)
+	{
+		OutLocation = Player->GetActorLocation();
+		return true;
+	}
+
+	// Headless runs have no player, so proxies are measured from a stand-in view
+	if (OutLocation.InitFromString(CVarEnemyProxyViewPoint.GetValueOnGameThread()))
+		return true;
+
+	if (!ActorRegistry)
+		return false;
+
+	int32 NumSpawners = 0;
+	FVector Sum = FVector::ZeroVector;
+	for (const AWaveSpawner* Spawner : ActorRegistry->GetSpawners())
+	{
+		if (Spawner)
+		{
+			Sum += Spawner->GetActorLocation();
+			++NumSpawners;
+		}
+	}
+
+	if (NumSpawners == 0)
+		return false;
+
+	OutLocation = Sum / NumSpawners;
+	return true;
+}
+
+bool UEnemyProxySubsystem::WantsProxy(const AEnemyBase* Enemy, const FVector& ViewLocation, float EnterDistSq, float ExitDistSq) const
+{
+	if (!Enemy->ProxyMesh || Enemy->bIsAttacking)
+		return false;
+
+	// Hysteresis so enemies on the boundary don't flip every frame
+	const float DistSq = FVector::DistSquared(Enemy->GetActorLocation(), ViewLocation);
+	return Enemy->IsProxy() ? DistSq > ExitDistSq : DistSq > EnterDistSq;
+}
+
+void UEnemyProxySubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_EnemyProxyUpdate);
+
+	FVector ViewLocation;
+	const bool bEnabled = CVarEnemyProxiesEnabled.GetValueOnGameThread() && GetViewLocation(ViewLocation);
+
+	const float EnterDistance = CVarEnemyProxyDistance.GetValueOnGameThread();
+	const float ExitDistance = FMath::Max(0.f, EnterDistance - CVarEnemyProxyHysteresis.GetValueOnGameThread());
+	const float EnterDistSq = FMath::Square(EnterDistance);
+	const float ExitDistSq = FMath::Square(ExitDistance);
+
+	int32 SwitchBudget = CVarEnemyProxySwitchBudget.GetValueOnGameThread();
+	int32 NumSwitches = 0;
+	int32 NumFull = 0;
+
+	for (AEnemyBase* Enemy : AEnemyManager::GetAllEnemies(GetWorld()))
+	{
+		if (!IsValid(Enemy) || Enemy->GetWorld() != GetWorld())
+			continue;
+
+		const bool bWantsProxy = bEnabled && WantsProxy(Enemy, ViewLocation, EnterDistSq, ExitDistSq);
+		if (bWantsProxy != Enemy->IsProxy())
+		{
+			if (!bWantsProxy)
+			{
+				ExitProxy(Enemy);
+				++NumSwitches;
+			}
+			else if (SwitchBudget > 0)
+			{
+				EnterProxy(Enemy);
+				--SwitchBudget;
+				++NumSwitches;
+			}
+		}
+
+		NumFull += Enemy->IsProxy() ? 0 : 1;
+	}
+
+	// One batched transform upload per class
+	for (TPair<UClass*, FProxyClass>& Pair : ProxyClasses)
+	{
+		FProxyClass& ProxyClass = Pair.Value;
+		if (ProxyClass.Owners.Num() == 0 || !ProxyClass.Instances)
+			continue;
+
+		ProxyClass.Transforms.SetNum(ProxyClass.Owners.Num(), false);
+		for (int32 Index = 0; Index < ProxyClass.Owners.Num(); ++Index)
+		{
+			ProxyClass.Transforms[Index] = ProxyClass.Owners[Index]->VisualMesh->GetComponentTransform();
+		}
+		ProxyClass.Instances->BatchUpdateInstancesTransforms(0, ProxyClass.Transforms, true, true, true);
+	}
+
+	SET_DWORD_STAT(STAT_EnemyProxy_Full, NumFull);
+	SET_DWORD_STAT(STAT_EnemyProxy_Proxies, NumProxies);
+	SET_DWORD_STAT(STAT_EnemyProxy_Switches, NumSwitches);
+}
+
+UEnemyProxySubsystem::FProxyClass& UEnemyProxySubsystem::GetProxyClass(const AEnemyBase* Enemy)
+{
+	FProxyClass& ProxyClass = ProxyClasses.FindOrAdd(Enemy->GetClass());
+	if (!ProxyClass.Instances)
+	{
+		if (!ProxyHost)
+		{
+			FActorSpawnParameters Params;
+			Params.Name = TEXT("EnemyProxyHost");
+			Params.ObjectFlags |= RF_Transient;
+			ProxyHost = GetWorld()->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, Params);
+			ProxyHost->SetRootComponent(NewObject<USceneComponent>(ProxyHost, TEXT("Root")));
+			ProxyHost->GetRootComponent()->RegisterComponent();
+		}
+
+		UInstancedStaticMeshComponent* Instances = NewObject<UInstancedStaticMeshComponent>(ProxyHost);
+		Instances->SetStaticMesh(Enemy->ProxyMesh);
+		Instances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		Instances->SetCastShadow(false);
+		Instances->SetupAttachment(ProxyHost->GetRootComponent());
+		Instances->RegisterComponent();
+		ProxyClass.Instances = Instances;
+	}
+	return ProxyClass;
+}
+
+void UEnemyProxySubsystem::EnterProxy(AEnemyBase* Enemy)
+{
+	FProxyClass& ProxyClass = GetProxyClass(Enemy);
+
+	USkeletalMeshComponent* Mesh = Enemy->VisualMesh;
+	Mesh->SetVisibility(false);
+	Mesh->SetComponentTickEnabled(false);
+	Mesh->ClearAnimScriptInstance();
+
+	Enemy->ProxyInstance = ProxyClass.Instances->AddInstance(Mesh->GetComponentTransform(), true);
+	ProxyClass.Owners.Add(Enemy);
+	++NumProxies;
+}
+
+void UEnemyProxySubsystem::ExitProxy(AEnemyBase* Enemy)
+{
+	if (!Enemy || !Enemy->IsProxy())
+		return;
+
+	RemoveInstance(Enemy);
+
+	USkeletalMeshComponent* Mesh = Enemy->VisualMesh;
+	Mesh->SetComponentTickEnabled(true);
+	Mesh->InitAnim(true);
+	Mesh->SetVisibility(true);
+}
+
+void UEnemyProxySubsystem::RemoveEnemy(AEnemyBase* Enemy)
+{
+	if (Enemy && Enemy->IsProxy())
+	{
+		RemoveInstance(Enemy);
+	}
+}
+
+void UEnemyProxySubsystem::RemoveInstance(AEnemyBase* Enemy)
+{
+	FProxyClass* ProxyClass = ProxyClasses.Find(Enemy->GetClass());
+	const int32 Index = Enemy->ProxyInstance;
+	Enemy->ProxyInstance = INDEX_NONE;
+
+	if (!ProxyClass || !ProxyClass->Owners.IsValidIndex(Index))
+		return;
+
+	// Move the last instance into the hole so removal never shifts the others
+	const int32 Last = ProxyClass->Owners.Num() - 1;
+	if (Index != Last)
+	{
+		AEnemyBase* Moved = ProxyClass->Owners[Last];
+		ProxyClass->Owners[Index] = Moved;
+		Moved->ProxyInstance = Index;
+
+		FTransform LastTransform;
+		ProxyClass->Instances->GetInstanceTransform(Last, LastTransform, true);
+		ProxyClass->Instances->UpdateInstanceTransform(Index, LastTransform, true, false, true);
+	}
+
+	ProxyClass->Owners.Pop(false);
+	ProxyClass->Instances->RemoveInstance(Last);
+	--NumProxies;
+}
+
+void UEnemyProxySubsystem::Report() const
+{
+	int32 NumFull = 0;
+	SIZE_T FullBytes = 0;
+	for (const AEnemyBase* Enemy : AEnemyManager::GetAllEnemies(GetWorld()))
+	{
+		if (!IsValid(Enemy) || Enemy->GetWorld() != GetWorld() || Enemy->IsProxy())
+			continue;
+
+		++NumFull;
+		FullBytes += Enemy->VisualMesh->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+		if (const UAnimInstance* AnimInstance = Enemy->VisualMesh->GetAnimInstance())
+		{
+			FullBytes += AnimInstance->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+		}
+	}
+
+	// Proxied enemies still own a hidden skeletal mesh component, without an anim instance
+	SIZE_T ProxyBytes = 0;
+	for (const TPair<UClass*, FProxyClass>& Pair : ProxyClasses)
+	{
+		if (Pair.Value.Instances)
+		{
+			ProxyBytes += Pair.Value.Instances->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+		}
+		for (const AEnemyBase* Enemy : Pair.Value.Owners)
+		{
+			ProxyBytes += Enemy->VisualMesh->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+		}
+	}
+
+	UE_LOG(LogEnemyProxy, Log, TEXT("Full: %d enemies, %.1f KB (%.1f KB each). Proxy: %d enemies in %d classes, %.1f KB (%.1f KB each)."),
+		NumFull, FullBytes / 1024.0, NumFull > 0 ? FullBytes / 1024.0 / NumFull : 0.0,
+		NumProxies, ProxyClasses.Num(), ProxyBytes / 1024.0, NumProxies > 0 ? ProxyBytes / 1024.0 / NumProxies : 0.0);
+}
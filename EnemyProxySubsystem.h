@@ -0,0 +1,60 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemyProxySubsystem.generated.h"
+
+class AEnemyBase;
+class UInstancedStaticMeshComponent;
+
+/**
+ * Distant enemies that are only walking are drawn as instances of one shared
+ * instanced static mesh per enemy class. Their skeletal mesh is hidden, stops
+ * ticking and drops its anim instance. They switch back to the full mesh when
+ * they get near the player or start attacking.
+ */
+UCLASS()
+class PROJECTSWAGGER_API UEnemyProxySubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UEnemyProxySubsystem* Get(const UWorld* World);
+
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Back to the full skeletal mesh straight away, e.g. when the enemy starts attacking
+	void ExitProxy(AEnemyBase* Enemy);
+
+	// Drops the enemy's instance, without touching its mesh. Call when the enemy leaves play.
+	void RemoveEnemy(AEnemyBase* Enemy);
+
+	int32 GetNumProxies() const { return NumProxies; }
+
+	// Logs counts and estimated memory for the full and proxy tiers
+	void Report() const;
+
+private:
+	struct FProxyClass
+	{
+		TObjectPtr<UInstancedStaticMeshComponent> Instances;
+		TArray<AEnemyBase*> Owners;
+		TArray<FTransform> Transforms;
+	};
+
+	bool WantsProxy(const AEnemyBase* Enemy, const FVector& ViewLocation, float EnterDistSq, float ExitDistSq) const;
+	void EnterProxy(AEnemyBase* Enemy);
+	void RemoveInstance(AEnemyBase* Enemy);
+	FProxyClass& GetProxyClass(const AEnemyBase* Enemy);
+	// The player, or without one the ProxyViewPoint CVar or the middle of the spawners
+	bool GetViewLocation(FVector& OutLocation) const;
+
+	UPROPERTY(Transient)
+	TObjectPtr<AActor> ProxyHost;
+
+	TMap<UClass*, FProxyClass> ProxyClasses;
+
+	int32 NumProxies = 0;
+};
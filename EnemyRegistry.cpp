@@ -0,0 +1,102 @@
+#include "Enemies/EnemyRegistry.h"
+#include "Enemies/EnemyBase.h"
+#include "GameplayMemoryTags.h"
+
+UEnemyRegistry* UEnemyRegistry::Get(const UWorld* World)
+{
+	return World ? World->GetSubsystem<UEnemyRegistry>() : nullptr;
+}
+
+void UEnemyRegistry::Deinitialize()
+{
+	for (AEnemyBase* Enemy : Enemies)
+	{
+		if (Enemy)
+		{
+			Enemy->RegistryHandle.Reset();
+		}
+	}
+
+	Slots.Reset();
+	FreeSlots.Reset();
+	Enemies.Reset();
+	DenseToSlot.Reset();
+
+	Super::Deinitialize();
+}
+
+FEnemyHandle UEnemyRegistry::RegisterEnemy(AEnemyBase* Enemy)
+{
+	LLM_SCOPE_BYTAG(Swagger_Registries);
+
+	if (!IsValid(Enemy))
+		return FEnemyHandle();
+
+	if (IsValidHandle(Enemy->RegistryHandle))
+		return Enemy->RegistryHandle;
+
+	const int32 SlotIndex = FreeSlots.Num() > 0 ? FreeSlots.Pop(false) : Slots.AddDefaulted();
+	FSlot& Slot = Slots[SlotIndex];
+
+	Slot.DenseIndex = Enemies.Add(Enemy);
+	DenseToSlot.Add(SlotIndex);
+
+	Enemy->RegistryHandle = { SlotIndex, Slot.Generation };
+	return Enemy->RegistryHandle;
+}
+
+void UEnemyRegistry::UnregisterEnemy(AEnemyBase* Enemy)
+{
+	if (!Enemy || !IsValidHandle(Enemy->RegistryHandle))
+		return;
+
+	FSlot& Slot = Slots[Enemy->RegistryHandle.Index];
+	const int32 DenseIndex = Slot.DenseIndex;
+	const int32 LastIndex = Enemies.Num() - 1;
+
+	// Keep the dense array packed by moving the last enemy into the hole
+	if (DenseIndex != LastIndex)
+	{
+		Enemies[DenseIndex] = Enemies[LastIndex];
+		DenseToSlot[DenseIndex] = DenseToSlot[LastIndex];
+		Slots[DenseToSlot[DenseIndex]].DenseIndex = DenseIndex;
+	}
+	Enemies.Pop(false);
+	DenseToSlot.Pop(false);
+
+	// Bumping the generation invalidates every handle to this slot
+	Slot.DenseIndex = INDEX_NONE;
+	++Slot.Generation;
+	FreeSlots.Add(Enemy->RegistryHandle.Index);
+
+	Enemy->RegistryHandle.Reset();
+}
+
+AEnemyBase* UEnemyRegistry::Resolve(const FEnemyHandle& Handle) const
+{
+	return IsValidHandle(Handle) ? Enemies[Slots[Handle.Index].DenseIndex].Get() : nullptr;
+}
+
+void UEnemyRegistry::TempAdjustMaxHealthForAll(float Value, bool IsAdding)
+{
+	for (AEnemyBase* Enemy : Enemies)
+	{
+		Enemy->TempAdjustMaxHealth(Value, IsAdding);
+	}
+}
+
+void UEnemyRegistry::AdjustMaxHealthForAll(float Value, bool IsAdding)
+{
+	for (AEnemyBase* Enemy : Enemies)
+	{
+		Enemy->AdjustMaxHealth(Value, IsAdding);
+	}
+}
+
+void UEnemyRegistry::ResetTempMaxHealthForAll()
+{
+	for (AEnemyBase* Enemy : Enemies)
+	{
+		Enemy->ResetTempMaxHealth();
+	}
+}
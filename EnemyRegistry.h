@@ -0,0 +1,74 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemyRegistry.generated.h"
+
+class AEnemyBase;
+
+// Index into the registry's slot table plus the slot's generation when it was handed out
+USTRUCT(BlueprintType)
+struct FEnemyHandle
+{
+	GENERATED_BODY()
+
+	int32 Index = INDEX_NONE;
+	uint32 Generation = 0;
+
+	bool IsSet() const { return Index != INDEX_NONE; }
+	void Reset() { Index = INDEX_NONE; Generation = 0; }
+
+	bool operator==(const FEnemyHandle& Other) const { return Index == Other.Index && Generation == Other.Generation; }
+	bool operator!=(const FEnemyHandle& Other) const { return !(*this == Other); }
+};
+
+/**
+ * Live enemies for one world, in a dense array with a slot map in front of it.
+ * Registering and unregistering are O(1), iteration walks the dense array, and a
+ * handle whose enemy has left is detected by its generation instead of being
+ * dereferenced.
+ */
+UCLASS()
+class PROJECTSWAGGER_API UEnemyRegistry : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UEnemyRegistry* Get(const UWorld* World);
+
+	virtual void Deinitialize() override;
+
+	FEnemyHandle RegisterEnemy(AEnemyBase* Enemy);
+	void UnregisterEnemy(AEnemyBase* Enemy);
+
+	// Null if the handle is stale
+	AEnemyBase* Resolve(const FEnemyHandle& Handle) const;
+
+	bool IsValidHandle(const FEnemyHandle& Handle) const
+	{
+		return Slots.IsValidIndex(Handle.Index) && Slots[Handle.Index].Generation == Handle.Generation && Slots[Handle.Index].DenseIndex != INDEX_NONE;
+	}
+
+	TConstArrayView<TObjectPtr<AEnemyBase>> GetEnemies() const { return Enemies; }
+	int32 Num() const { return Enemies.Num(); }
+
+	void TempAdjustMaxHealthForAll(float Value, bool IsAdding);
+	void AdjustMaxHealthForAll(float Value, bool IsAdding);
+	void ResetTempMaxHealthForAll();
+
+private:
+	struct FSlot
+	{
+		int32 DenseIndex = INDEX_NONE;
+		uint32 Generation = 0;
+	};
+
+	TArray<FSlot> Slots;
+	TArray<int32> FreeSlots;
+
+	UPROPERTY()
+	TArray<TObjectPtr<AEnemyBase>> Enemies;
+
+	// Slot index for each dense entry
+	TArray<int32> DenseToSlot;
+};
@@ -0,0 +1,287 @@
+#include "Enemies/EnemySimSubsystem.h"
+#include "Enemies/EnemyBase.h"
+#include "Enemies/EnemyManager.h"
+
+DECLARE_STATS_GROUP(TEXT("EnemySim"), STATGROUP_EnemySim, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Fixed Steps"), STAT_EnemySimStep, STATGROUP_EnemySim);
+DECLARE_CYCLE_STAT(TEXT("Interpolate"), STAT_EnemySimInterpolate, STATGROUP_EnemySim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Enemies Stepped"), STAT_EnemySim_Stepped, STATGROUP_EnemySim);
+
+static TAutoConsoleVariable<bool> CVarEnemyFixedSim(
+	TEXT("Swagger.Enemies.FixedSim"),
+	true,
+	TEXT("Step enemies at a fixed rate with interpolated transforms instead of every frame."));
+
+static TAutoConsoleVariable<float> CVarEnemySimRate(
+	TEXT("Swagger.Enemies.SimRate"),
+	30.0f,
+	TEXT("Fixed steps per second for each enemy."));
+
+static TAutoConsoleVariable<int32> CVarEnemySimBuckets(
+	TEXT("Swagger.Enemies.SimBuckets"),
+	2,
+	TEXT("Groups enemies are split into. Buckets step one after another, spreading each sim step across frames."));
+
+// Caps catch-up after a long frame so a hitch doesn't turn into a burst of steps
+static constexpr int32 MaxStepsPerFrame = 8;
+
+static int32 GetSimBucketCount()
+{
+	return FMath::Clamp(CVarEnemySimBuckets.GetValueOnGameThread(), 1, 8);
+}
+
+static float GetSimStepDelta()
+{
+	return 1.0f / FMath::Clamp(CVarEnemySimRate.GetValueOnGameThread(), 5.0f, 120.0f);
+}
+
+UEnemySimSubsystem* UEnemySimSubsystem::Get(const UWorld* World)
+{
+	return World ? World->GetSubsystem<UEnemySimSubsystem>() : nullptr;
+}
+
+void UEnemySimSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	bEnabled = CVarEnemyFixedSim.GetValueOnGameThread();
+}
+
+void UEnemySimSubsystem::Deinitialize()
+{
+	for (const TArray<AEnemyBase*>& Bucket : Buckets)
+	{
+		for (AEnemyBase* Enemy : Bucket)
+		{
+			Enemy->SimBucket = INDEX_NONE;
+			Enemy->SimSlot = INDEX_NONE;
+		}
+	}
+	Buckets.Reset();
+	NumEnemies = 0;
+
+	Super::Deinitialize();
+}
+
+TStatId UEnemySimSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemySimSubsystem, STATGROUP_Tickables);
+}
+
+void UEnemySimSubsystem::RegisterEnemy(AEnemyBase* Enemy)
+{
+	if (!bEnabled || !Enemy || Enemy->SimSlot != INDEX_NONE)
+		return;
+
+	if (Buckets.IsEmpty())
+	{
+		SetNumBuckets(GetSimBucketCount());
+	}
+
+	// Into the smallest bucket, so they stay even as enemies die
+	int32 Smallest = 0;
+	for (int32 Bucket = 1; Bucket < Buckets.Num(); ++Bucket)
+	{
+		if (Buckets[Bucket].Num() < Buckets[Smallest].Num())
+		{
+			Smallest = Bucket;
+		}
+	}
+
+	Enemy->SimBucket = Smallest;
+	Enemy->SimSlot = Buckets[Smallest].Add(Enemy);
+	++NumEnemies;
+
+	Enemy->SimLocation = Enemy->PrevSimLocation = Enemy->GetActorLocation();
+	if (!Enemy->HasBlueprintTick())
+	{
+		Enemy->SetActorTickEnabled(false);
+	}
+}
+
+void UEnemySimSubsystem::UnregisterEnemy(AEnemyBase* Enemy)
+{
+	if (!Enemy || !Buckets.IsValidIndex(Enemy->SimBucket))
+		return;
+
+	TArray<AEnemyBase*>& Bucket = Buckets[Enemy->SimBucket];
+	const int32 Slot = Enemy->SimSlot;
+	if (!Bucket.IsValidIndex(Slot) || Bucket[Slot] != Enemy)
+		return;
+
+	// Swapping within the bucket keeps everyone else in theirs
+	Bucket.RemoveAtSwap(Slot, 1, false);
+	if (Bucket.IsValidIndex(Slot))
+	{
+		Bucket[Slot]->SimSlot = Slot;
+	}
+
+	Enemy->SimBucket = INDEX_NONE;
+	Enemy->SimSlot = INDEX_NONE;
+	--NumEnemies;
+}
+
+void UEnemySimSubsystem::SetNumBuckets(int32 NumBuckets)
+{
+	TArray<AEnemyBase*> All;
+	All.Reserve(NumEnemies);
+	for (const TArray<AEnemyBase*>& Bucket : Buckets)
+	{
+		All.Append(Bucket);
+	}
+
+	Buckets.SetNum(NumBuckets);
+	for (TArray<AEnemyBase*>& Bucket : Buckets)
+	{
+		Bucket.Reset();
+	}
+
+	for (int32 Index = 0; Index < All.Num(); ++Index)
+	{
+		AEnemyBase* Enemy = All[Index];
+		Enemy->SimBucket = Index % NumBuckets;
+		Enemy->SimSlot = Buckets[Enemy->SimBucket].Add(Enemy);
+	}
+
+	BucketStepTime.Init(SimClock, NumBuckets);
+	NextBucket = 0;
+}
+
+void UEnemySimSubsystem::SetEnabled(bool bEnable)
+{
+	bEnabled = bEnable;
+
+	if (bEnable)
+	{
+		for (AEnemyBase* Enemy : AEnemyManager::GetAllEnemies(GetWorld()))
+		{
+			if (IsValid(Enemy))
+			{
+				RegisterEnemy(Enemy);
+			}
+		}
+		return;
+	}
+
+	// Copied out, unregistering reorders the buckets
+	TArray<AEnemyBase*> Stepped;
+	for (const TArray<AEnemyBase*>& Bucket : Buckets)
+	{
+		Stepped.Append(Bucket);
+	}
+
+	for (AEnemyBase* Enemy : Stepped)
+	{
+		// The actor is already at its sim location, just bring the mesh back onto it
+		Enemy->SetMeshDrawOffset(FVector::ZeroVector);
+		UnregisterEnemy(Enemy);
+		Enemy->SetActorTickEnabled(true);
+	}
+}
+
+uint32 UEnemySimSubsystem::GetDueBuckets(float DeltaTime) const
+{
+	const int32 NumBuckets = GetSimBucketCount();
+	if (Buckets.Num() != NumBuckets)
+		return MAX_uint32;
+
+	// Same count Tick will run, barring rounding at the edge of a step
+	const float SubStep = GetSimStepDelta() / NumBuckets;
+	const int32 Steps = FMath::Min(FMath::FloorToInt((Accumulator + DeltaTime) / SubStep), FMath::Min(MaxStepsPerFrame, NumBuckets));
+
+	uint32 Due = 0;
+	for (int32 Step = 0; Step < Steps; ++Step)
+	{
+		Due |= 1u << ((NextBucket + Step) % NumBuckets);
+	}
+	return Due;
+}
+
+void UEnemySimSubsystem::Tick(float DeltaTime)
+{
+	const bool bWantEnabled = CVarEnemyFixedSim.GetValueOnGameThread();
+	if (bWantEnabled != bEnabled)
+	{
+		SetEnabled(bWantEnabled);
+	}
+
+	if (!bEnabled || NumEnemies == 0)
+		return;
+
+	const int32 NumBuckets = GetSimBucketCount();
+	const float StepDelta = GetSimStepDelta();
+	const float SubStep = StepDelta / NumBuckets;
+
+	if (Buckets.Num() != NumBuckets)
+	{
+		SetNumBuckets(NumBuckets);
+	}
+
+	StepFrame = GFrameCounter;
+	Accumulator += DeltaTime;
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_EnemySimStep);
+
+		int32 Steps = 0;
+		while (Accumulator >= SubStep && Steps < MaxStepsPerFrame)
+		{
+			Accumulator -= SubStep;
+			SimClock += SubStep;
+
+			StepBucket(NextBucket, StepDelta);
+			NextBucket = (NextBucket + 1) % NumBuckets;
+			++Steps;
+		}
+
+		// Dropped time is lost rather than simulated later
+		Accumulator = FMath::Min(Accumulator, SubStep);
+	}
+
+	Interpolate(StepDelta);
+}
+
+void UEnemySimSubsystem::StepBucket(int32 Bucket, float StepDelta)
+{
+	BucketStepTime[Bucket] = SimClock;
+
+	// Stepping can kill or spawn enemies, so run over a copy of this bucket
+	TArray<AEnemyBase*, TInlineAllocator<256>> ToStep;
+	ToStep.Append(Buckets[Bucket]);
+
+	INC_DWORD_STAT_BY(STAT_EnemySim_Stepped, ToStep.Num());
+
+	for (AEnemyBase* Enemy : ToStep)
+	{
+		if (!IsValid(Enemy) || Enemy->SimSlot == INDEX_NONE)
+			continue;
+
+		// The actor never left its sim location, so it steps from where it stands
+		const bool bFirstStepThisFrame = Enemy->SimStepFrame != StepFrame;
+		Enemy->SimStepFrame = StepFrame;
+		Enemy->SimulateStep(StepDelta, bFirstStepThisFrame);
+
+		// May have died or been merged into an elite during the step
+		if (Enemy->SimSlot == INDEX_NONE)
+			continue;
+
+		Enemy->PrevSimLocation = Enemy->SimLocation;
+		Enemy->SimLocation = Enemy->GetActorLocation();
+	}
+}
+
+void UEnemySimSubsystem::Interpolate(float StepDelta)
+{
+	SCOPE_CYCLE_COUNTER(STAT_EnemySimInterpolate);
+
+	const double Now = SimClock + Accumulator;
+	for (int32 Bucket = 0; Bucket < Buckets.Num(); ++Bucket)
+	{
+		const float Alpha = FMath::Clamp(float((Now - BucketStepTime[Bucket]) / StepDelta), 0.0f, 1.0f);
+		for (AEnemyBase* Enemy : Buckets[Bucket])
+		{
+			// Standing still draws with no offset, which SetMeshDrawOffset skips once it's there
+			Enemy->SetMeshDrawOffset((Enemy->PrevSimLocation - Enemy->SimLocation) * (1.0f - Alpha));
+		}
+	}
+}
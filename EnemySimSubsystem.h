@@ -0,0 +1,72 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemySimSubsystem.generated.h"
+
+class AEnemyBase;
+
+/**
+ * Steps enemy movement and attacks at a fixed rate instead of once per rendered
+ * frame. Enemies are split into buckets and each frame only steps the buckets that
+ * are due, so the cost per frame stays flat as the frame rate goes up. The actors
+ * and their collision stay at the sim location; between steps only their meshes
+ * (and the proxy instances that follow them) are drawn interpolated from the
+ * previous to the current sim location.
+ *
+ * Stepped enemies have their actor tick turned off unless their class implements
+ * the Blueprint Tick, which then keeps running every frame but no longer moves them.
+ */
+UCLASS()
+class PROJECTSWAGGER_API UEnemySimSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UEnemySimSubsystem* Get(const UWorld* World);
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Takes over the enemy's tick while fixed stepping is on
+	void RegisterEnemy(AEnemyBase* Enemy);
+	void UnregisterEnemy(AEnemyBase* Enemy);
+
+	int32 Num() const { return NumEnemies; }
+
+	bool IsEnabled() const { return bEnabled; }
+
+	// Buckets that will step in a frame of DeltaTime, one bit each. All bits if the buckets are about to be rebuilt.
+	uint32 GetDueBuckets(float DeltaTime) const;
+
+	int32 GetNumBuckets() const { return Buckets.Num(); }
+	TConstArrayView<AEnemyBase*> GetBucket(int32 Bucket) const { return Buckets[Bucket]; }
+
+private:
+	void StepBucket(int32 Bucket, float StepDelta);
+	void Interpolate(float StepDelta);
+
+	// Spreads every enemy over a new number of buckets
+	void SetNumBuckets(int32 NumBuckets);
+
+	// Hands every enemy back to its own tick, or takes them all, when the CVar changes
+	void SetEnabled(bool bEnable);
+
+	// An enemy stays in the bucket it was added to, so it steps at a steady rate as others come and go
+	TArray<TArray<AEnemyBase*>> Buckets;
+	int32 NumEnemies = 0;
+
+	// Sim clock at each bucket's last step, for the interpolation alpha
+	TArray<double> BucketStepTime;
+
+	double SimClock = 0.0;
+	float Accumulator = 0.0f;
+	int32 NextBucket = 0;
+
+	// Engine frame being stepped. The parallel decision is only good for an enemy's first step in it.
+	uint64 StepFrame = 0;
+
+	bool bEnabled = false;
+};
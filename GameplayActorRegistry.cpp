@@ -0,0 +1,112 @@
+#include "GameplayActorRegistry.h"
+#include "Enemies/WaveSpawner.h"
+#include "Interactables/Base/BPI_GateControl.h"
+#include "ProjectSwagger/ProjectSwaggerCharacter.h"
+#include "EngineUtils.h"
+#include "Algo/BinarySearch.h"
+#include "GameplayMemoryTags.h"
+
+UGameplayActorRegistry* UGameplayActorRegistry::Get(const UWorld* World)
+{
+	return World ? World->GetSubsystem<UGameplayActorRegistry>() : nullptr;
+}
+
+void UGameplayActorRegistry::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	ActorSpawnedHandle = GetWorld()->AddOnActorSpawnedHandler(
+		FOnActorSpawned::FDelegate::CreateUObject(this, &UGameplayActorRegistry::OnActorSpawned));
+}
+
+void UGameplayActorRegistry::Deinitialize()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+	}
+
+	Spawners.Reset();
+	Gates.Reset();
+	Player.Reset();
+
+	Super::Deinitialize();
+}
+
+void UGameplayActorRegistry::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// One pass for level-placed gates and a player spawned before we were listening
+	for (TActorIterator<AActor> It(&InWorld); It; ++It)
+	{
+		ConsiderActor(*It);
+	}
+}
+
+void UGameplayActorRegistry::RegisterSpawner(AWaveSpawner* Spawner)
+{
+	LLM_SCOPE_BYTAG(Swagger_Registries);
+
+	if (!IsValid(Spawner) || Spawners.Contains(Spawner))
+		return;
+
+	const int32 Index = Algo::UpperBoundBy(Spawners, Spawner->SpawnerNumber, [](const TObjectPtr<AWaveSpawner>& Other) { return Other->SpawnerNumber; });
+	Spawners.Insert(Spawner, Index);
+}
+
+void UGameplayActorRegistry::UnregisterSpawner(AWaveSpawner* Spawner)
+{
+	// Keeps the sort order
+	Spawners.RemoveSingle(Spawner);
+}
+
+void UGameplayActorRegistry::RegisterGate(AActor* Gate)
+{
+	if (!IsValid(Gate) || Gates.Contains(Gate))
+		return;
+
+	Gates.Add(Gate);
+	Gate->OnEndPlay.AddUniqueDynamic(this, &UGameplayActorRegistry::OnTrackedActorEndPlay);
+}
+
+void UGameplayActorRegistry::UnregisterGate(AActor* Gate)
+{
+	Gates.RemoveSingle(Gate);
+}
+
+void UGameplayActorRegistry::ConsiderActor(AActor* Actor)
+{
+	if (!IsValid(Actor))
+		return;
+
+	if (Actor->GetClass()->ImplementsInterface(UBPI_GateControl::StaticClass()))
+	{
+		RegisterGate(Actor);
+	}
+	else if (AProjectSwaggerCharacter* Character = Cast<AProjectSwaggerCharacter>(Actor))
+	{
+		if (!Player.IsValid())
+		{
+			Player = Character;
+			Character->OnEndPlay.AddUniqueDynamic(this, &UGameplayActorRegistry::OnTrackedActorEndPlay);
+		}
+	}
+}
+
+void UGameplayActorRegistry::OnActorSpawned(AActor* Actor)
+{
+	ConsiderActor(Actor);
+}
+
+void UGameplayActorRegistry::OnTrackedActorEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason)
+{
+	if (Player.Get() == Actor)
+	{
+		Player.Reset();
+	}
+	else
+	{
+		UnregisterGate(Actor);
+	}
+}
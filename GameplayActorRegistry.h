@@ -0,0 +1,62 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GameplayActorRegistry.generated.h"
+
+class AWaveSpawner;
+class AProjectSwaggerCharacter;
+
+/**
+ * Gameplay actors that used to be found by scanning the world. Spawners register
+ * themselves and stay sorted by spawner number. Gates and the player are picked
+ * up once at world begin play and then as they spawn. Walls and nodes live in
+ * their own registries.
+ */
+UCLASS()
+class PROJECTSWAGGER_API UGameplayActorRegistry : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UGameplayActorRegistry* Get(const UWorld* World);
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	void RegisterSpawner(AWaveSpawner* Spawner);
+	void UnregisterSpawner(AWaveSpawner* Spawner);
+
+	// Sorted by SpawnerNumber
+	TConstArrayView<TObjectPtr<AWaveSpawner>> GetSpawners() const { return Spawners; }
+
+	// For gates spawned in ways the spawn handler can't see, e.g. level streaming
+	UFUNCTION(BlueprintCallable, Category = "Registry")
+	void RegisterGate(AActor* Gate);
+
+	UFUNCTION(BlueprintCallable, Category = "Registry")
+	void UnregisterGate(AActor* Gate);
+
+	// Actors implementing BPI_GateControl
+	TConstArrayView<TObjectPtr<AActor>> GetGates() const { return Gates; }
+
+	AProjectSwaggerCharacter* GetPlayer() const { return Player.Get(); }
+
+private:
+	void ConsiderActor(AActor* Actor);
+	void OnActorSpawned(AActor* Actor);
+
+	UFUNCTION()
+	void OnTrackedActorEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason);
+
+	UPROPERTY()
+	TArray<TObjectPtr<AWaveSpawner>> Spawners;
+
+	UPROPERTY()
+	TArray<TObjectPtr<AActor>> Gates;
+
+	TWeakObjectPtr<AProjectSwaggerCharacter> Player;
+
+	FDelegateHandle ActorSpawnedHandle;
+};
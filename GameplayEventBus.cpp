@@ -0,0 +1,93 @@
+#include "GameplayEventBus.h"
+#include "GameEvents.h"
+
+DECLARE_STATS_GROUP(TEXT("GameplayEvents"), STATGROUP_GameplayEvents, STATCAT_Advanced);
+DECLARE_DWORD_COUNTER_STAT(TEXT("EnemyAttack Dispatches"), STAT_Events_EnemyAttack, STATGROUP_GameplayEvents);
+DECLARE_DWORD_COUNTER_STAT(TEXT("DifficultyIncreased Dispatches"), STAT_Events_DifficultyIncreased, STATGROUP_GameplayEvents);
+
+static TAutoConsoleVariable<bool> CVarForwardEventsToBlueprint(
+	TEXT("Swagger.Events.ForwardToBlueprint"),
+	true,
+	TEXT("Also broadcast the UGameEvents Blueprint delegates when native events are dispatched."));
+
+UGameplayEventBus* UGameplayEventBus::Get(const UWorld* World)
+{
+	return World ? World->GetSubsystem<UGameplayEventBus>() : nullptr;
+}
+
+void UGameplayEventBus::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &UGameplayEventBus::OnWorldPostActorTick);
+}
+
+void UGameplayEventBus::Deinitialize()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+
+	for (TUniquePtr<FChannelBase>& Channel : Channels)
+	{
+		Channel.Reset();
+	}
+
+	Super::Deinitialize();
+}
+
+void UGameplayEventBus::DiscardDeferred()
+{
+	for (TUniquePtr<FChannelBase>& Channel : Channels)
+	{
+		if (Channel)
+		{
+			Channel->DiscardDeferred();
+		}
+	}
+}
+
+void UGameplayEventBus::OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World != GetWorld())
+		return;
+
+	for (TUniquePtr<FChannelBase>& Channel : Channels)
+	{
+		if (Channel)
+		{
+			Channel->FlushDeferred();
+		}
+	}
+
+	auto TakeFrameCount = [this](EGameplayEventChannel Channel) -> uint32
+	{
+		FChannelBase* Found = Channels[static_cast<int32>(Channel)].Get();
+		return Found ? Found->DispatchesThisFrame : 0;
+	};
+
+	SET_DWORD_STAT(STAT_Events_EnemyAttack, TakeFrameCount(EGameplayEventChannel::EnemyAttack));
+	SET_DWORD_STAT(STAT_Events_DifficultyIncreased, TakeFrameCount(EGameplayEventChannel::DifficultyIncreased));
+
+	for (TUniquePtr<FChannelBase>& Channel : Channels)
+	{
+		if (Channel)
+		{
+			Channel->DispatchesThisFrame = 0;
+		}
+	}
+}
+
+void UGameplayEventBus::ForwardToBlueprint(const FEnemyAttackEvent& Event)
+{
+	if (CVarForwardEventsToBlueprint.GetValueOnGameThread() && UGameEvents::OnEnemyAttack.IsBound())
+	{
+		UGameEvents::OnEnemyAttack.Broadcast();
+	}
+}
+
+void UGameplayEventBus::ForwardToBlueprint(const FDifficultyIncreasedEvent& Event)
+{
+	if (CVarForwardEventsToBlueprint.GetValueOnGameThread() && UGameEvents::OnDifficultyIncreasing.IsBound())
+	{
+		UGameEvents::OnDifficultyIncreasing.Broadcast();
+	}
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GameplayEventBus.generated.h"
+
+class AEnemyBase;
+class ABorderWall;
+class AWaveSpawner;
+
+enum class EGameplayEventChannel : uint8
+{
+	EnemyAttack,
+	DifficultyIncreased,
+
+	Count
+};
+
+// Payloads. Actor pointers may be pending kill by the time a deferred event is dispatched.
+struct FEnemyAttackEvent
+{
+	static constexpr EGameplayEventChannel Channel = EGameplayEventChannel::EnemyAttack;
+
+	AEnemyBase* Attacker = nullptr;
+	ABorderWall* Wall = nullptr;
+	float Damage = 0.f;
+};
+
+struct FDifficultyIncreasedEvent
+{
+	static constexpr EGameplayEventChannel Channel = EGameplayEventChannel::DifficultyIncreased;
+
+	AWaveSpawner* Spawner = nullptr;
+	int32 Wave = 0;
+};
+
+/**
+ * Native gameplay events with typed payloads. Channels are resolved at compile time
+ * from the payload type. Publish dispatches immediately, Enqueue at the end of the
+ * world tick. The old UGameEvents Blueprint delegates still fire, but only when
+ * something is bound to them.
+ */
+UCLASS()
+class PROJECTSWAGGER_API UGameplayEventBus : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UGameplayEventBus* Get(const UWorld* World);
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	template<typename TEvent>
+	TMulticastDelegate<void(const TEvent&)>& On()
+	{
+		return GetChannel<TEvent>().Listeners;
+	}
+
+	template<typename TEvent>
+	void Publish(const TEvent& Event)
+	{
+		GetChannel<TEvent>().Dispatch(Event);
+	}
+
+	template<typename TEvent>
+	void Enqueue(const TEvent& Event)
+	{
+		GetChannel<TEvent>().Deferred.Add(Event);
+	}
+
+	// Drops every enqueued event without dispatching it, e.g. when the state they describe is replaced
+	void DiscardDeferred();
+
+	uint64 GetDispatchCount(EGameplayEventChannel Channel) const
+	{
+		const FChannelBase* Found = Channels[static_cast<int32>(Channel)].Get();
+		return Found ? Found->DispatchCount : 0;
+	}
+
+private:
+	struct FChannelBase
+	{
+		virtual ~FChannelBase() = default;
+		virtual void FlushDeferred() = 0;
+		virtual void DiscardDeferred() = 0;
+
+		uint64 DispatchCount = 0;
+		uint32 DispatchesThisFrame = 0;
+	};
+
+	template<typename TEvent>
+	struct TChannel final : FChannelBase
+	{
+		void Dispatch(const TEvent& Event)
+		{
+			++DispatchCount;
+			++DispatchesThisFrame;
+			Listeners.Broadcast(Event);
+			ForwardToBlueprint(Event);
+		}
+
+		virtual void FlushDeferred() override
+		{
+			// Listeners may enqueue more; those go out next frame
+			TArray<TEvent> Pending = MoveTemp(Deferred);
+			for (const TEvent& Event : Pending)
+			{
+				Dispatch(Event);
+			}
+		}
+
+		virtual void DiscardDeferred() override
+		{
+			Deferred.Reset();
+		}
+
+		TMulticastDelegate<void(const TEvent&)> Listeners;
+		TArray<TEvent> Deferred;
+	};
+
+	template<typename TEvent>
+	TChannel<TEvent>& GetChannel()
+	{
+		constexpr int32 Index = static_cast<int32>(TEvent::Channel);
+		static_assert(Index < static_cast<int32>(EGameplayEventChannel::Count), "Event payload has no channel");
+
+		TUniquePtr<FChannelBase>& Channel = Channels[Index];
+		if (!Channel)
+		{
+			Channel = MakeUnique<TChannel<TEvent>>();
+		}
+		return static_cast<TChannel<TEvent>&>(*Channel);
+	}
+
+	// Blueprint adapters, one per payload type
+	static void ForwardToBlueprint(const FEnemyAttackEvent& Event);
+	static void ForwardToBlueprint(const FDifficultyIncreasedEvent& Event);
+
+	void OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+	TUniquePtr<FChannelBase> Channels[static_cast<int32>(EGameplayEventChannel::Count)];
+
+	FDelegateHandle PostActorTickHandle;
+};
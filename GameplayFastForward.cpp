@@ -0,0 +1,156 @@
+#include "GameplayFastForward.h"
+#include "Enemies/WaveSpawnerManager.h"
+#include "Misc/App.h"
+#include "Misc/CoreDelegates.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogFastForward, Log, All);
+
+DECLARE_STATS_GROUP(TEXT("FastForward"), STATGROUP_FastForward, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Extra Steps"), STAT_FastForwardSteps, STATGROUP_FastForward);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Sim Seconds per Second"), STAT_FastForwardSpeed, STATGROUP_FastForward);
+
+static FAutoConsoleCommandWithWorldAndArgs GFastForwardCommand(
+	TEXT("Swagger.FastForward"),
+	TEXT("Steps gameplay several times per frame. Swagger.FastForward <StepsPerFrame> [FixedDelta]. 0 or 1 goes back to normal speed."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		UGameplayFastForwardSubsystem* FastForward = UGameplayFastForwardSubsystem::Get(World);
+		if (!FastForward)
+			return;
+
+		const int32 Steps = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 0;
+		const float Delta = Args.Num() > 1 ? FCString::Atof(*Args[1]) : 1.0f / 30.0f;
+		FastForward->SetFastForward(Steps, Delta);
+	}));
+
+UGameplayFastForwardSubsystem* UGameplayFastForwardSubsystem::Get(const UWorld* World)
+{
+	return World ? World->GetSubsystem<UGameplayFastForwardSubsystem>() : nullptr;
+}
+
+bool UGameplayFastForwardSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UGameplayFastForwardSubsystem::Deinitialize()
+{
+	Stop();
+
+	Super::Deinitialize();
+}
+
+void UGameplayFastForwardSubsystem::SetFastForward(int32 InStepsPerFrame, float InFixedDelta)
+{
+	if (InStepsPerFrame <= 1 || InFixedDelta <= 0.0f)
+	{
+		Stop();
+		return;
+	}
+
+	if (!IsFastForwarding())
+	{
+		bPreviousUseFixedTimeStep = FApp::UseFixedTimeStep();
+		PreviousFixedDeltaTime = FApp::GetFixedDeltaTime();
+
+		TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateUObject(this, &UGameplayFastForwardSubsystem::TickExtraSteps));
+	}
+
+	StepsPerFrame = InStepsPerFrame;
+	FixedDelta = InFixedDelta;
+	StartWallTime = FPlatformTime::Seconds();
+	LastReportTime = StartWallTime;
+	SimulatedSeconds = 0.0;
+
+	// The engine's own world tick takes the same delta as the extra steps and stops waiting on real time
+	FApp::SetUseFixedTimeStep(true);
+	FApp::SetFixedDeltaTime(FixedDelta);
+
+	UE_LOG(LogFastForward, Log, TEXT("Fast forward on: %d steps of %.4fs per frame"), StepsPerFrame, FixedDelta);
+}
+
+void UGameplayFastForwardSubsystem::Stop()
+{
+	if (!IsFastForwarding())
+		return;
+
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	TickerHandle.Reset();
+
+	FApp::SetUseFixedTimeStep(bPreviousUseFixedTimeStep);
+	FApp::SetFixedDeltaTime(PreviousFixedDeltaTime);
+
+	UE_LOG(LogFastForward, Log, TEXT("Fast forward off: %.0f simulated seconds at %.1fx"), SimulatedSeconds, GetSpeed());
+
+	StepsPerFrame = 0;
+}
+
+float UGameplayFastForwardSubsystem::GetSpeed() const
+{
+	const double WallSeconds = FPlatformTime::Seconds() - StartWallTime;
+	return WallSeconds > 0.0 ? float(SimulatedSeconds / WallSeconds) : 0.0f;
+}
+
+bool UGameplayFastForwardSubsystem::TickExtraSteps(float DeltaTime)
+{
+	UWorld* World = GetWorld();
+	if (!World || !IsFastForwarding())
+		return true;
+
+	if (!World->IsPaused())
+	{
+		SCOPE_CYCLE_COUNTER(STAT_FastForwardSteps);
+
+		// The engine ticks the world once this frame already
+		for (int32 Step = 1; Step < StepsPerFrame; ++Step)
+		{
+			StepWorld(World, FixedDelta, false);
+		}
+
+		SimulatedSeconds += double(FixedDelta) * StepsPerFrame;
+	}
+
+	SET_FLOAT_STAT(STAT_FastForwardSpeed, GetSpeed());
+
+	const double Now = FPlatformTime::Seconds();
+	if (Now - LastReportTime >= 5.0)
+	{
+		LastReportTime = Now;
+
+		const AWaveSpawnerManager* Manager = AWaveSpawnerManager::Get(World);
+		UE_LOG(LogFastForward, Log, TEXT("Fast forward: %.1f simulated seconds per second, wave %d"),
+			GetSpeed(), Manager ? Manager->GetWaveCount() : 0);
+	}
+
+	return true;
+}
+
+void UGameplayFastForwardSubsystem::StepWorld(UWorld* World, float DeltaSeconds, bool bHeadless)
+{
+	// Timers and tick functions refuse a second tick in the same frame, so every step is its own frame
+	++GFrameCounter;
+
+	if (bHeadless)
+	{
+		FApp::SetDeltaTime(DeltaSeconds);
+		FApp::SetCurrentTime(FApp::GetCurrentTime() + DeltaSeconds);
+		FCoreDelegates::OnBeginFrame.Broadcast();
+	}
+
+	World->Tick(LEVELTICK_All, DeltaSeconds);
+
+	if (bHeadless)
+	{
+		// Nothing else pumps async loads in a commandlet, and the first wave waits on the enemy preload
+		if (IsAsyncLoading())
+		{
+			ProcessAsyncLoading(true, false, 0.005);
+		}
+
+		FTSTicker::GetCoreTicker().Tick(DeltaSeconds);
+
+		// Ends the frame for anything keyed to it, like the gameplay frame arena
+		FCoreDelegates::OnEndFrame.Broadcast();
+	}
+}
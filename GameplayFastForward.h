@@ -0,0 +1,56 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GameplayFastForward.generated.h"
+
+/**
+ * Runs gameplay faster than real time by stepping the world at a fixed delta several
+ * times per rendered frame. Every step is a full world tick at the same delta, so
+ * timers, enemy movement, attacks and hazard rolls behave as they would at normal
+ * speed, just more of them per second. The soak commandlet uses the same step with
+ * no rendering at all.
+ */
+UCLASS()
+class PROJECTSWAGGER_API UGameplayFastForwardSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UGameplayFastForwardSubsystem* Get(const UWorld* World);
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+
+	// StepsPerFrame of 0 or 1 goes back to normal speed
+	UFUNCTION(BlueprintCallable, Category = "Debug")
+	void SetFastForward(int32 InStepsPerFrame, float InFixedDelta = 0.0333333f);
+
+	UFUNCTION(BlueprintPure, Category = "Debug")
+	bool IsFastForwarding() const { return StepsPerFrame > 1; }
+
+	// Simulated seconds per wall clock second since fast forward started
+	UFUNCTION(BlueprintPure, Category = "Debug")
+	float GetSpeed() const;
+
+	// One full world tick outside the engine's own. Headless, the step also stands in for the engine frame around it.
+	static void StepWorld(UWorld* World, float DeltaSeconds, bool bHeadless);
+
+private:
+	bool TickExtraSteps(float DeltaTime);
+	void Stop();
+
+	FTSTicker::FDelegateHandle TickerHandle;
+
+	int32 StepsPerFrame = 0;
+	float FixedDelta = 0.0f;
+
+	double StartWallTime = 0.0;
+	double SimulatedSeconds = 0.0;
+	double LastReportTime = 0.0;
+
+	// Engine fixed step settings from before fast forward, put back when it stops
+	bool bPreviousUseFixedTimeStep = false;
+	double PreviousFixedDeltaTime = 0.0;
+};
@@ -0,0 +1,155 @@
+#include "GameplayFrameArena.h"
+#include "GameplayMemoryTags.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DelayedAutoRegister.h"
+#include "Misc/Parse.h"
+
+DECLARE_STATS_GROUP(TEXT("GameplayMemory"), STATGROUP_GameplayMemory, STATCAT_Advanced);
+DECLARE_MEMORY_STAT(TEXT("Frame Arena Used"), STAT_FrameArenaUsed, STATGROUP_GameplayMemory);
+DECLARE_MEMORY_STAT(TEXT("Frame Arena Reserved"), STAT_FrameArenaReserved, STATGROUP_GameplayMemory);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Frame Arena Heap Fallbacks"), STAT_FrameArenaHeapFallbacks, STATGROUP_GameplayMemory);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Frame Arena Page Allocations"), STAT_FrameArenaPageAllocations, STATGROUP_GameplayMemory);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Gameplay Heap Allocations"), STAT_GameplayHeapAllocations, STATGROUP_GameplayMemory);
+
+#if !UE_BUILD_SHIPPING
+namespace GameplayHeapCounter
+{
+	static thread_local int32 ScopeDepth = 0;
+	static std::atomic<uint32> Allocations{ 0 };
+
+	// Forwards everything to the real allocator, counting allocations made inside a gameplay heap scope
+	class FCountingMalloc final : public FMalloc
+	{
+	public:
+		explicit FCountingMalloc(FMalloc* InInner) : Inner(InInner) {}
+
+		virtual void* Malloc(SIZE_T Size, uint32 Alignment) override { Count(); return Inner->Malloc(Size, Alignment); }
+		virtual void* TryMalloc(SIZE_T Size, uint32 Alignment) override { Count(); return Inner->TryMalloc(Size, Alignment); }
+		virtual void* Realloc(void* Ptr, SIZE_T NewSize, uint32 Alignment) override { Count(); return Inner->Realloc(Ptr, NewSize, Alignment); }
+		virtual void* TryRealloc(void* Ptr, SIZE_T NewSize, uint32 Alignment) override { Count(); return Inner->TryRealloc(Ptr, NewSize, Alignment); }
+		virtual void Free(void* Ptr) override { Inner->Free(Ptr); }
+
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+		virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+		virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+		virtual void InitializeStatsMetadata() override { Inner->InitializeStatsMetadata(); }
+		virtual void UpdateStats() override { Inner->UpdateStats(); }
+		virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override { Inner->GetAllocatorStats(OutStats); }
+		virtual void DumpAllocatorStats(FOutputDevice& Ar) override { Inner->DumpAllocatorStats(Ar); }
+		virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+		virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+		virtual const TCHAR* GetDescriptiveName() override { return Inner->GetDescriptiveName(); }
+
+	private:
+		FORCEINLINE void Count()
+		{
+			if (ScopeDepth > 0)
+			{
+				Allocations.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+
+		FMalloc* Inner;
+	};
+
+	static void Install()
+	{
+		if (GMalloc && FParse::Param(FCommandLine::Get(), TEXT("GameplayHeapCounters")))
+		{
+			// Blocks from before the swap stay valid, the proxy frees through the same allocator
+			GMalloc = new FCountingMalloc(GMalloc);
+		}
+	}
+}
+
+FGameplayHeapScope::FGameplayHeapScope()
+{
+	++GameplayHeapCounter::ScopeDepth;
+}
+
+FGameplayHeapScope::~FGameplayHeapScope()
+{
+	--GameplayHeapCounter::ScopeDepth;
+}
+#endif
+
+// With the module, not on first use: the counters and stats run from the first frame, and the allocator
+// is swapped during startup instead of mid-game while other threads are allocating
+static FDelayedAutoRegisterHelper GGameplayFrameArenaStartup(EDelayedRegisterRunPhase::ObjectSystemReady, []()
+{
+#if !UE_BUILD_SHIPPING
+	GameplayHeapCounter::Install();
+#endif
+	FGameplayFrameArena::Get();
+});
+
+FGameplayFrameArena& FGameplayFrameArena::Get()
+{
+	static FGameplayFrameArena Arena;
+	return Arena;
+}
+
+FGameplayFrameArena::FGameplayFrameArena()
+{
+	FCoreDelegates::OnEndFrame.AddRaw(this, &FGameplayFrameArena::EndFrame);
+}
+
+void* FGameplayFrameArena::Allocate(SIZE_T Size, uint32 Alignment)
+{
+	if (!IsInGameThread() || Size + Alignment > PageSize)
+		return nullptr;
+
+	while (true)
+	{
+		if (Pages.IsValidIndex(CurrentPage))
+		{
+			FPage& Page = Pages[CurrentPage];
+			const SIZE_T AlignedOffset = Align(reinterpret_cast<UPTRINT>(Page.Data) + PageOffset, Alignment) - reinterpret_cast<UPTRINT>(Page.Data);
+			if (AlignedOffset + Size <= Page.Size)
+			{
+				PageOffset = AlignedOffset + Size;
+				BytesUsed += Size;
+				return Page.Data + AlignedOffset;
+			}
+
+			++CurrentPage;
+			PageOffset = 0;
+			continue;
+		}
+
+		// Kept across frames, so this only happens while the working set is still growing
+		LLM_SCOPE_BYTAG(Swagger_Pools);
+		FPage& NewPage = Pages.AddDefaulted_GetRef();
+		NewPage.Data = static_cast<uint8*>(FMemory::Malloc(PageSize, 16));
+		NewPage.Size = PageSize;
+		++PageAllocationsThisFrame;
+	}
+}
+
+void FGameplayFrameArena::EndFrame()
+{
+	LastFrameStats.BytesUsed = BytesUsed;
+	LastFrameStats.PeakBytesUsed = FMath::Max(LastFrameStats.PeakBytesUsed, BytesUsed);
+	LastFrameStats.BytesReserved = Pages.Num() * PageSize;
+	LastFrameStats.HeapFallbacks = HeapFallbacksThisFrame;
+	LastFrameStats.PageAllocations = PageAllocationsThisFrame;
+#if !UE_BUILD_SHIPPING
+	LastFrameStats.ScopedHeapAllocations = GameplayHeapCounter::Allocations.exchange(0, std::memory_order_relaxed);
+#endif
+
+	SET_MEMORY_STAT(STAT_FrameArenaUsed, LastFrameStats.BytesUsed);
+	SET_MEMORY_STAT(STAT_FrameArenaReserved, LastFrameStats.BytesReserved);
+	SET_DWORD_STAT(STAT_FrameArenaHeapFallbacks, LastFrameStats.HeapFallbacks);
+	SET_DWORD_STAT(STAT_FrameArenaPageAllocations, LastFrameStats.PageAllocations);
+	SET_DWORD_STAT(STAT_GameplayHeapAllocations, LastFrameStats.ScopedHeapAllocations);
+
+	CurrentPage = 0;
+	PageOffset = 0;
+	BytesUsed = 0;
+	HeapFallbacksThisFrame = 0;
+	PageAllocationsThisFrame = 0;
+	++Generation;
+}
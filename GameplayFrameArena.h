@@ -0,0 +1,208 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Linear scratch memory for gameplay temporaries on the game thread. Everything
+ * allocated from it is released at once at the end of the frame, and its pages are
+ * kept, so steady state costs no heap allocations. Containers using it must not
+ * outlive the frame.
+ */
+class PROJECTSWAGGER_API FGameplayFrameArena
+{
+public:
+	static FGameplayFrameArena& Get();
+
+	// Null off the game thread or when a request can't fit in a page; callers fall back to the heap
+	void* Allocate(SIZE_T Size, uint32 Alignment);
+
+	uint32 GetGeneration() const { return Generation; }
+
+	// Counted by containers that had to fall back to the heap
+	void NotifyHeapFallback() { ++HeapFallbacksThisFrame; }
+
+	struct FFrameStats
+	{
+		SIZE_T BytesUsed = 0;
+		SIZE_T PeakBytesUsed = 0;
+		SIZE_T BytesReserved = 0;
+		uint32 HeapFallbacks = 0;
+		uint32 PageAllocations = 0;
+		uint32 ScopedHeapAllocations = 0;
+	};
+
+	const FFrameStats& GetLastFrameStats() const { return LastFrameStats; }
+
+private:
+	FGameplayFrameArena();
+
+	void EndFrame();
+
+	static constexpr SIZE_T PageSize = 64 * 1024;
+
+	struct FPage
+	{
+		uint8* Data = nullptr;
+		SIZE_T Size = 0;
+	};
+
+	TArray<FPage> Pages;
+	int32 CurrentPage = 0;
+	SIZE_T PageOffset = 0;
+	SIZE_T BytesUsed = 0;
+
+	uint32 Generation = 0;
+	uint32 HeapFallbacksThisFrame = 0;
+	uint32 PageAllocationsThisFrame = 0;
+
+	FFrameStats LastFrameStats;
+};
+
+/**
+ * TArray allocator policy backed by the frame arena, modeled on TMemStackAllocator.
+ * Falls back to the heap off the game thread or when the arena can't serve a request.
+ */
+template<uint32 Alignment = DEFAULT_ALIGNMENT>
+class TGameplayFrameAllocator
+{
+public:
+	using SizeType = int32;
+
+	enum { NeedsElementType = true };
+	enum { RequireRangeCheck = true };
+
+	class ForAnyElementType
+	{
+	public:
+		ForAnyElementType() = default;
+		ForAnyElementType(const ForAnyElementType&) = delete;
+		ForAnyElementType& operator=(const ForAnyElementType&) = delete;
+
+		~ForAnyElementType()
+		{
+			if (bHeap)
+			{
+				FMemory::Free(Data);
+			}
+		}
+
+		FORCEINLINE void MoveToEmpty(ForAnyElementType& Other)
+		{
+			checkSlow(this != &Other);
+			if (bHeap)
+			{
+				FMemory::Free(Data);
+			}
+
+			Data = Other.Data;
+			bHeap = Other.bHeap;
+			Generation = Other.Generation;
+
+			Other.Data = nullptr;
+			Other.bHeap = false;
+		}
+
+		FORCEINLINE FScriptContainerElement* GetAllocation() const { return Data; }
+
+		void ResizeAllocation(SizeType PreviousNumElements, SizeType NumElements, SIZE_T NumBytesPerElement)
+		{
+			ResizeAllocation(PreviousNumElements, NumElements, NumBytesPerElement, Alignment);
+		}
+
+		void ResizeAllocation(SizeType PreviousNumElements, SizeType NumElements, SIZE_T NumBytesPerElement, uint32 AlignmentOfElement)
+		{
+			const uint32 ActualAlignment = FMath::Max(Alignment, AlignmentOfElement);
+
+			if (bHeap)
+			{
+				Data = (FScriptContainerElement*)FMemory::Realloc(Data, NumElements * NumBytesPerElement, ActualAlignment);
+				bHeap = Data != nullptr;
+				return;
+			}
+
+			FGameplayFrameArena& Arena = FGameplayFrameArena::Get();
+			ensureMsgf(!Data || Generation == Arena.GetGeneration(), TEXT("Frame arena container outlived its frame"));
+
+			if (NumElements == 0)
+			{
+				Data = nullptr;
+				return;
+			}
+
+			FScriptContainerElement* OldData = Data;
+			Data = (FScriptContainerElement*)Arena.Allocate(NumElements * NumBytesPerElement, ActualAlignment);
+			Generation = Arena.GetGeneration();
+
+			if (!Data)
+			{
+				Arena.NotifyHeapFallback();
+				Data = (FScriptContainerElement*)FMemory::Malloc(NumElements * NumBytesPerElement, ActualAlignment);
+				bHeap = true;
+			}
+
+			if (OldData && PreviousNumElements)
+			{
+				FMemory::Memcpy(Data, OldData, FMath::Min(PreviousNumElements, NumElements) * NumBytesPerElement);
+			}
+		}
+
+		FORCEINLINE SizeType CalculateSlackReserve(SizeType NumElements, SIZE_T NumBytesPerElement) const
+		{
+			return DefaultCalculateSlackReserve(NumElements, NumBytesPerElement, false, Alignment);
+		}
+		FORCEINLINE SizeType CalculateSlackShrink(SizeType NumElements, SizeType NumAllocatedElements, SIZE_T NumBytesPerElement) const
+		{
+			return DefaultCalculateSlackShrink(NumElements, NumAllocatedElements, NumBytesPerElement, false, Alignment);
+		}
+		FORCEINLINE SizeType CalculateSlackGrow(SizeType NumElements, SizeType NumAllocatedElements, SIZE_T NumBytesPerElement) const
+		{
+			return DefaultCalculateSlackGrow(NumElements, NumAllocatedElements, NumBytesPerElement, false, Alignment);
+		}
+
+		SIZE_T GetAllocatedSize(SizeType NumAllocatedElements, SIZE_T NumBytesPerElement) const
+		{
+			return NumAllocatedElements * NumBytesPerElement;
+		}
+
+		bool HasAllocation() const { return !!Data; }
+		SizeType GetInitialCapacity() const { return 0; }
+
+	private:
+		FScriptContainerElement* Data = nullptr;
+		uint32 Generation = 0;
+		bool bHeap = false;
+	};
+
+	template<typename ElementType>
+	class ForElementType : public ForAnyElementType
+	{
+	public:
+		FORCEINLINE ElementType* GetAllocation() const
+		{
+			return (ElementType*)ForAnyElementType::GetAllocation();
+		}
+	};
+};
+
+template<uint32 Alignment>
+struct TAllocatorTraits<TGameplayFrameAllocator<Alignment>> : TAllocatorTraitsBase<TGameplayFrameAllocator<Alignment>>
+{
+	enum { SupportsMove = true };
+};
+
+using FGameplayFrameAllocator = TGameplayFrameAllocator<>;
+
+template<typename T>
+using TFrameArray = TArray<T, FGameplayFrameAllocator>;
+
+#if !UE_BUILD_SHIPPING
+// Counts heap allocations made on this thread while in scope. Enabled with -GameplayHeapCounters.
+struct PROJECTSWAGGER_API FGameplayHeapScope
+{
+	FGameplayHeapScope();
+	~FGameplayHeapScope();
+};
+#define GAMEPLAY_HEAP_SCOPE() FGameplayHeapScope ANONYMOUS_VARIABLE(GameplayHeapScope)
+#else
+#define GAMEPLAY_HEAP_SCOPE()
+#endif
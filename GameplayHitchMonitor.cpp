@@ -0,0 +1,191 @@
+#include "GameplayHitchMonitor.h"
+#include "Enemies/EnemyRegistry.h"
+#include "Enemies/WaveSpawnerManager.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "ProfilingDebugging/TraceAuxiliary.h"
+#include "RenderCore.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGameplayHitch, Log, All);
+
+DECLARE_STATS_GROUP(TEXT("GameplayHitches"), STATGROUP_GameplayHitches, STATCAT_Advanced);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Slowest Event (ms)"), STAT_GameplayHitch_EventMs, STATGROUP_GameplayHitches);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Hitch Dumps"), STAT_GameplayHitch_Dumps, STATGROUP_GameplayHitches);
+
+static TAutoConsoleVariable<bool> CVarHitchMonitorEnabled(
+	TEXT("Swagger.Hitch.Enabled"),
+	!UE_BUILD_SHIPPING,
+	TEXT("Record frame timings and dump the window around frames over the hitch threshold."));
+
+static TAutoConsoleVariable<float> CVarHitchThresholdMs(
+	TEXT("Swagger.Hitch.ThresholdMs"),
+	60.f,
+	TEXT("Frame time in milliseconds that counts as a hitch."));
+
+static TAutoConsoleVariable<float> CVarHitchPreSeconds(
+	TEXT("Swagger.Hitch.PreSeconds"),
+	3.f,
+	TEXT("Seconds of samples before the hitch to include in the dump."));
+
+static TAutoConsoleVariable<float> CVarHitchPostSeconds(
+	TEXT("Swagger.Hitch.PostSeconds"),
+	1.f,
+	TEXT("Seconds to keep recording after the hitch before the dump is written."));
+
+static TAutoConsoleVariable<float> CVarHitchCooldown(
+	TEXT("Swagger.Hitch.Cooldown"),
+	10.f,
+	TEXT("Minimum seconds between two dumps, so a bad stretch doesn't flood the disk."));
+
+static FAutoConsoleCommandWithWorld GHitchDumpCommand(
+	TEXT("Swagger.Hitch.Dump"),
+	TEXT("Writes the current hitch monitor window to Saved/Hitches."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (UGameplayHitchMonitor* Monitor = UGameplayHitchMonitor::Get(World))
+		{
+			Monitor->DumpNow(TEXT("Manual"));
+		}
+	}));
+
+UGameplayHitchMonitor* UGameplayHitchMonitor::Get(const UWorld* World)
+{
+	return World ? World->GetSubsystem<UGameplayHitchMonitor>() : nullptr;
+}
+
+TStatId UGameplayHitchMonitor::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UGameplayHitchMonitor, STATGROUP_Tickables);
+}
+
+void UGameplayHitchMonitor::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	Samples.SetNum(MaxSamples);
+	NextSample = 0;
+	LastTickTime = 0.0;
+}
+
+void UGameplayHitchMonitor::NoteEvent(const TCHAR* Label, double Milliseconds)
+{
+	if (IsInGameThread() && Milliseconds > FrameEventMs)
+	{
+		FrameEvent = Label;
+		FrameEventMs = Milliseconds;
+	}
+}
+
+void UGameplayHitchMonitor::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// Events are noted between two ticks, which is the same interval the frame time covers
+	const TCHAR* Event = FrameEvent;
+	const double EventMs = FrameEventMs;
+	FrameEvent = nullptr;
+	FrameEventMs = 0.0;
+
+	const double Now = FPlatformTime::Seconds();
+	const double Previous = LastTickTime;
+	LastTickTime = Now;
+
+	if (!CVarHitchMonitorEnabled.GetValueOnGameThread() || Previous <= 0.0)
+		return;
+
+	FFrameSample Sample;
+	Sample.Time = Now;
+	Sample.FrameMs = float((Now - Previous) * 1000.0);
+	Sample.GameThreadMs = FPlatformTime::ToMilliseconds(GGameThreadTime);
+	Sample.Event = Event;
+	Sample.EventMs = float(EventMs);
+
+	const AWaveSpawnerManager* Manager = AWaveSpawnerManager::Get(GetWorld());
+	Sample.Wave = Manager ? Manager->GetWaveCount() : 0;
+	const UEnemyRegistry* Enemies = UEnemyRegistry::Get(GetWorld());
+	Sample.LiveEnemies = Enemies ? Enemies->Num() : 0;
+
+	AddSample(Sample);
+
+	SET_FLOAT_STAT(STAT_GameplayHitch_EventMs, EventMs);
+
+	if (bHasPendingHitch)
+	{
+		const float PostSeconds = CVarHitchPostSeconds.GetValueOnGameThread();
+		if (Now - PendingHitch.Time >= PostSeconds)
+		{
+			bHasPendingHitch = false;
+			WriteDump(PendingHitch, PendingHitch.Time - CVarHitchPreSeconds.GetValueOnGameThread(), PendingHitch.Time + PostSeconds);
+		}
+		return;
+	}
+
+	if (Sample.FrameMs >= CVarHitchThresholdMs.GetValueOnGameThread() && Now - LastDumpTime >= CVarHitchCooldown.GetValueOnGameThread())
+	{
+		PendingHitch = Sample;
+		bHasPendingHitch = true;
+
+		UE_LOG(LogGameplayHitch, Warning, TEXT("Hitch: %.1f ms on wave %d with %d enemies during %s"),
+			Sample.FrameMs, Sample.Wave, Sample.LiveEnemies, Sample.Event ? Sample.Event : TEXT("(none)"));
+	}
+}
+
+void UGameplayHitchMonitor::AddSample(const FFrameSample& Sample)
+{
+	Samples[NextSample] = Sample;
+	NextSample = (NextSample + 1) % MaxSamples;
+}
+
+void UGameplayHitchMonitor::DumpNow(const TCHAR* Reason)
+{
+	const int32 Newest = (NextSample + MaxSamples - 1) % MaxSamples;
+
+	FFrameSample Marker = Samples[Newest];
+	Marker.Event = Reason;
+	WriteDump(Marker, Marker.Time - CVarHitchPreSeconds.GetValueOnGameThread(), Marker.Time);
+}
+
+void UGameplayHitchMonitor::WriteDump(const FFrameSample& Hitch, double WindowStart, double WindowEnd)
+{
+	LastDumpTime = FPlatformTime::Seconds();
+	++NumDumps;
+	SET_DWORD_STAT(STAT_GameplayHitch_Dumps, NumDumps);
+
+	const FString Directory = FPaths::ProjectSavedDir() / TEXT("Hitches");
+	IFileManager::Get().MakeDirectory(*Directory, true);
+
+	const FString BaseName = FString::Printf(TEXT("Hitch_%s_Wave%d"), *FDateTime::Now().ToString(), Hitch.Wave);
+
+	TStringBuilder<16384> Csv;
+	Csv.Appendf(TEXT("# HitchMs=%.2f Wave=%d LiveEnemies=%d Event=%s EventMs=%.2f\n"),
+		Hitch.FrameMs, Hitch.Wave, Hitch.LiveEnemies, Hitch.Event ? Hitch.Event : TEXT(""), Hitch.EventMs);
+	Csv.Append(TEXT("TimeFromHitch,FrameMs,GameThreadMs,Wave,LiveEnemies,Event,EventMs\n"));
+
+	// Oldest first
+	for (int32 Offset = 0; Offset < MaxSamples; ++Offset)
+	{
+		const FFrameSample& Sample = Samples[(NextSample + Offset) % MaxSamples];
+		if (Sample.Time <= 0.0 || Sample.Time < WindowStart || Sample.Time > WindowEnd)
+			continue;
+
+		Csv.Appendf(TEXT("%.4f,%.2f,%.2f,%d,%d,%s,%.2f\n"), Sample.Time - Hitch.Time, Sample.FrameMs, Sample.GameThreadMs,
+			Sample.Wave, Sample.LiveEnemies, Sample.Event ? Sample.Event : TEXT(""), Sample.EventMs);
+	}
+
+	const FString CsvPath = Directory / (BaseName + TEXT(".csv"));
+	FFileHelper::SaveStringToFile(Csv.ToView(), *CsvPath);
+
+	// Trace keeps its tail in memory, so the frames around the hitch are already in it
+	FString TracePath;
+#if UE_TRACE_ENABLED
+	TracePath = Directory / (BaseName + TEXT(".utrace"));
+	if (!FTraceAuxiliary::WriteSnapshot(*TracePath))
+	{
+		TracePath.Reset();
+	}
+#endif
+
+	UE_LOG(LogGameplayHitch, Warning, TEXT("Wrote hitch window to %s%s%s"), *CsvPath,
+		TracePath.IsEmpty() ? TEXT("") : TEXT(" and "), *TracePath);
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "GameplayHitchMonitor.generated.h"
+
+/**
+ * Keeps a rolling window of per-frame timings tagged with the wave, live enemy
+ * count and the slowest labelled gameplay event of the frame. When a frame goes
+ * over the hitch threshold, the samples around it are written to Saved/Hitches as
+ * CSV, along with a snapshot of the trace tail buffer when trace is running.
+ */
+UCLASS()
+class PROJECTSWAGGER_API UGameplayHitchMonitor : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UGameplayHitchMonitor* Get(const UWorld* World);
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Called by FGameplayHitchScope. Keeps the slowest labelled event of the current frame.
+	void NoteEvent(const TCHAR* Label, double Milliseconds);
+
+	// Writes the current window straight away, without waiting for a hitch
+	void DumpNow(const TCHAR* Reason);
+
+	int32 GetNumDumps() const { return NumDumps; }
+
+private:
+	struct FFrameSample
+	{
+		double Time = 0.0;
+		float FrameMs = 0.0f;
+		float GameThreadMs = 0.0f;
+		int32 Wave = 0;
+		int32 LiveEnemies = 0;
+		const TCHAR* Event = nullptr;
+		float EventMs = 0.0f;
+	};
+
+	void AddSample(const FFrameSample& Sample);
+	void WriteDump(const FFrameSample& Hitch, double WindowStart, double WindowEnd);
+
+	static constexpr int32 MaxSamples = 2048;
+
+	TArray<FFrameSample> Samples;
+	int32 NextSample = 0;
+
+	double LastTickTime = 0.0;
+	double LastDumpTime = -MAX_dbl;
+
+	// Hitch waiting for the frames after it before being written
+	FFrameSample PendingHitch;
+	bool bHasPendingHitch = false;
+
+	int32 NumDumps = 0;
+
+	// Slowest labelled event in this world since the last tick
+	const TCHAR* FrameEvent = nullptr;
+	double FrameEventMs = 0.0;
+};
+
+// Labels a block of gameplay code so a hitch during it is attributed to it in the
+// monitor of the world it ran in
+struct FGameplayHitchScope
+{
+	FGameplayHitchScope(const UWorld* World, const TCHAR* InLabel)
+		: Monitor(UGameplayHitchMonitor::Get(World))
+		, Label(InLabel)
+		, StartCycles(FPlatformTime::Cycles64())
+	{
+	}
+
+	~FGameplayHitchScope()
+	{
+		if (Monitor)
+		{
+			Monitor->NoteEvent(Label, FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles));
+		}
+	}
+
+	UGameplayHitchMonitor* Monitor;
+	const TCHAR* Label;
+	uint64 StartCycles;
+};
+
+// Label must be a string literal. Also shows up as a CPU event in Insights.
+#define GAMEPLAY_HITCH_SCOPE(World, Label) \
+	TRACE_CPUPROFILER_EVENT_SCOPE_STR(Label); \
+	FGameplayHitchScope ANONYMOUS_VARIABLE(GameplayHitchScope)(World, TEXT(Label))
@@ -0,0 +1,72 @@
+#include "GameplayMemoryTags.h"
+#include "Enemies/EnemyRegistry.h"
+#include "Enemies/WaveSpawnerManager.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGameplayMemory, Log, All);
+
+LLM_DEFINE_TAG(Swagger);
+LLM_DEFINE_TAG(Swagger_Enemies);
+LLM_DEFINE_TAG(Swagger_HealthBars);
+LLM_DEFINE_TAG(Swagger_Waves);
+LLM_DEFINE_TAG(Swagger_NodeInventory);
+LLM_DEFINE_TAG(Swagger_Pools);
+LLM_DEFINE_TAG(Swagger_Registries);
+
+static TAutoConsoleVariable<bool> CVarWaveMemoryReport(
+	TEXT("Swagger.Memory.WaveReport"),
+	true,
+	TEXT("Log per-tag gameplay memory at every wave boundary when LLM is enabled."));
+
+static FAutoConsoleCommandWithWorld GMemoryReportCommand(
+	TEXT("Swagger.Memory.Report"),
+	TEXT("Logs current and peak LLM memory for the gameplay tags."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		const AWaveSpawnerManager* Manager = AWaveSpawnerManager::Get(World);
+		const UEnemyRegistry* Enemies = UEnemyRegistry::Get(World);
+		FGameplayMemoryReport::LogWave(Manager ? Manager->GetWaveCount() : 0, Enemies ? Enemies->Num() : 0);
+	}));
+
+void FGameplayMemoryReport::LogWave(int32 Wave, int32 LiveEnemies)
+{
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+	if (!FLowLevelMemTracker::IsEnabled() || !CVarWaveMemoryReport.GetValueOnGameThread())
+		return;
+
+	static const TCHAR* const TagNames[] =
+	{
+		TEXT("Swagger/Enemies"),
+		TEXT("Swagger/HealthBars"),
+		TEXT("Swagger/Waves"),
+		TEXT("Swagger/NodeInventory"),
+		TEXT("Swagger/Pools"),
+		TEXT("Swagger/Registries"),
+	};
+
+	// Amounts from the previous report, for the per-wave change
+	static int64 PreviousAmounts[UE_ARRAY_COUNT(TagNames)] = {};
+
+	FLowLevelMemTracker& Tracker = FLowLevelMemTracker::Get();
+	auto ToKB = [](int64 Bytes) { return double(Bytes) / 1024.0; };
+
+	UE_LOG(LogGameplayMemory, Log, TEXT("Wave %d memory, %d live enemies:"), Wave, LiveEnemies);
+
+	int64 Total = 0;
+	for (int32 Index = 0; Index < UE_ARRAY_COUNT(TagNames); ++Index)
+	{
+		const FName TagName(TagNames[Index]);
+		const int64 Current = Tracker.GetTagAmountForTracker(ELLMTracker::Default, TagName, ELLMTagSet::None, false);
+		const int64 Peak = Tracker.GetTagAmountForTracker(ELLMTracker::Default, TagName, ELLMTagSet::None, true);
+
+		UE_LOG(LogGameplayMemory, Log, TEXT("  %-22s %10.1f KB  peak %10.1f KB  change %+10.1f KB"),
+			TagNames[Index], ToKB(Current), ToKB(Peak), ToKB(Current - PreviousAmounts[Index]));
+
+		PreviousAmounts[Index] = Current;
+		Total += Current;
+	}
+
+	const int64 EnemyBytes = PreviousAmounts[0] + PreviousAmounts[1];
+	UE_LOG(LogGameplayMemory, Log, TEXT("  Total %.1f KB, %.1f KB per enemy"),
+		ToKB(Total), LiveEnemies > 0 ? ToKB(EnemyBytes) / LiveEnemies : 0.0);
+#endif
+}
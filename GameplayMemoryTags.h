@@ -0,0 +1,24 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+
+// LLM tags for gameplay allocations. Underscores become the tag path, so these show
+// up under Swagger/ in "stat LLMFULL" and LLM CSVs. Tracking needs -llm on the command line.
+LLM_DECLARE_TAG_API(Swagger, PROJECTSWAGGER_API);
+LLM_DECLARE_TAG_API(Swagger_Enemies, PROJECTSWAGGER_API);
+LLM_DECLARE_TAG_API(Swagger_HealthBars, PROJECTSWAGGER_API);
+LLM_DECLARE_TAG_API(Swagger_Waves, PROJECTSWAGGER_API);
+LLM_DECLARE_TAG_API(Swagger_NodeInventory, PROJECTSWAGGER_API);
+LLM_DECLARE_TAG_API(Swagger_Pools, PROJECTSWAGGER_API);
+LLM_DECLARE_TAG_API(Swagger_Registries, PROJECTSWAGGER_API);
+
+/**
+ * Logs current and peak LLM memory for each gameplay tag, with the change since the
+ * previous report and memory per live enemy. Called at every wave boundary.
+ */
+class PROJECTSWAGGER_API FGameplayMemoryReport
+{
+public:
+	static void LogWave(int32 Wave, int32 LiveEnemies);
+};
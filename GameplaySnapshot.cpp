@@ -0,0 +1,340 @@
+#include "GameplaySnapshot.h"
+#include "Enemies/EnemyBase.h"
+#include "Enemies/EnemyManager.h"
+#include "Enemies/WaveSpawner.h"
+#include "Enemies/WaveSpawnerManager.h"
+#include "Enemies/EnemyDamageSubsystem.h"
+#include "Environment/BorderWall.h"
+#include "Environment/BorderWallRegistry.h"
+#include "NPCs/NPCNodeSlot.h"
+#include "NPCs/NPCNodeRegistry.h"
+#include "NPCs/NPCCharacter.h"
+#include "GameplayActorRegistry.h"
+#include "GameplayEventBus.h"
+#include "EngineUtils.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGameplaySnapshot, Log, All);
+
+namespace GameplaySnapshot
+{
+	static constexpr uint32 Magic = 0x4E535753; // "SWSN"
+	static constexpr int32 Version = 3;
+
+	template<typename TActor>
+	TMap<FName, TActor*> GatherByName(TConstArrayView<TObjectPtr<TActor>> Registered)
+	{
+		TMap<FName, TActor*> Actors;
+		Actors.Reserve(Registered.Num());
+		for (TActor* Actor : Registered)
+		{
+			if (Actor)
+			{
+				Actors.Add(Actor->GetFName(), Actor);
+			}
+		}
+		return Actors;
+	}
+
+	// NPCs have no registry of their own
+	TMap<FName, ANPCCharacter*> GatherNPCsByName(UWorld* World)
+	{
+		TMap<FName, ANPCCharacter*> NPCs;
+		for (TActorIterator<ANPCCharacter> It(World); It; ++It)
+		{
+			NPCs.Add(It->GetFName(), *It);
+		}
+		return NPCs;
+	}
+
+	TConstArrayView<TObjectPtr<AWaveSpawner>> GetSpawners(const UWorld* World)
+	{
+		const UGameplayActorRegistry* Registry = UGameplayActorRegistry::Get(World);
+		return Registry ? Registry->GetSpawners() : TConstArrayView<TObjectPtr<AWaveSpawner>>();
+	}
+
+	TConstArrayView<TObjectPtr<ABorderWall>> GetWalls(const UWorld* World)
+	{
+		const UBorderWallRegistry* Registry = UBorderWallRegistry::Get(World);
+		return Registry ? Registry->GetAllWalls() : TConstArrayView<TObjectPtr<ABorderWall>>();
+	}
+
+	TConstArrayView<TObjectPtr<ANPCNodeSlot>> GetNodes(const UWorld* World)
+	{
+		const UNPCNodeRegistry* Registry = UNPCNodeRegistry::Get(World);
+		return Registry ? Registry->GetNodes() : TConstArrayView<TObjectPtr<ANPCNodeSlot>>();
+	}
+}
+
+static FAutoConsoleCommandWithWorldAndArgs GSnapshotCaptureCommand(
+	TEXT("Swagger.Snapshot.Capture"),
+	TEXT("Captures the gameplay state to the in-memory checkpoint, or to Saved/Snapshots/<Name>.snap if a name is given."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (UGameplaySnapshotSubsystem* Snapshots = UGameplaySnapshotSubsystem::Get(World))
+		{
+			Snapshots->CaptureCheckpoint();
+			if (Args.Num() > 0)
+			{
+				Snapshots->SaveCheckpointToFile(Args[0]);
+			}
+		}
+	}));
+
+static FAutoConsoleCommandWithWorldAndArgs GSnapshotRestoreCommand(
+	TEXT("Swagger.Snapshot.Restore"),
+	TEXT("Restores the in-memory checkpoint, or Saved/Snapshots/<Name>.snap if a name is given."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (UGameplaySnapshotSubsystem* Snapshots = UGameplaySnapshotSubsystem::Get(World))
+		{
+			if (Args.Num() > 0 && !Snapshots->LoadCheckpointFromFile(Args[0]))
+				return;
+
+			Snapshots->RestoreCheckpoint();
+		}
+	}));
+
+UGameplaySnapshotSubsystem* UGameplaySnapshotSubsystem::Get(const UWorld* World)
+{
+	return World ? World->GetSubsystem<UGameplaySnapshotSubsystem>() : nullptr;
+}
+
+void UGameplaySnapshotSubsystem::Capture(TArray<uint8>& OutData) const
+{
+	UWorld* World = GetWorld();
+
+	OutData.Reset();
+	FMemoryWriter Ar(OutData);
+
+	uint32 Magic = GameplaySnapshot::Magic;
+	int32 Version = GameplaySnapshot::Version;
+	Ar << Magic << Version;
+
+	FWaveManagerStateRecord ManagerRecord;
+	bool bHasManager = false;
+	if (const AWaveSpawnerManager* Manager = AWaveSpawnerManager::Get(World))
+	{
+		Manager->SaveState(ManagerRecord);
+		bHasManager = true;
+	}
+	Ar << bHasManager << ManagerRecord;
+
+	TArray<FWaveSpawnerStateRecord> SpawnerRecords;
+	for (const AWaveSpawner* Spawner : GameplaySnapshot::GetSpawners(World))
+	{
+		if (Spawner)
+		{
+			Spawner->SaveState(SpawnerRecords.AddDefaulted_GetRef());
+		}
+	}
+	Ar << SpawnerRecords;
+
+	TArray<FEnemyStateRecord> EnemyRecords;
+	EnemyRecords.Reserve(AEnemyManager::GetAllEnemies(GetWorld()).Num());
+	for (const AEnemyBase* Enemy : AEnemyManager::GetAllEnemies(GetWorld()))
+	{
+		if (IsValid(Enemy) && Enemy->GetWorld() == World)
+		{
+			Enemy->SaveState(EnemyRecords.AddDefaulted_GetRef());
+		}
+	}
+	Ar << EnemyRecords;
+
+	TArray<FBorderWallStateRecord> WallRecords;
+	for (const ABorderWall* Wall : GameplaySnapshot::GetWalls(World))
+	{
+		if (Wall)
+		{
+			Wall->SaveState(WallRecords.AddDefaulted_GetRef());
+		}
+	}
+	Ar << WallRecords;
+
+	TArray<FNPCNodeStateRecord> NodeRecords;
+	for (const ANPCNodeSlot* Node : GameplaySnapshot::GetNodes(World))
+	{
+		if (Node)
+		{
+			Node->SaveState(NodeRecords.AddDefaulted_GetRef());
+		}
+	}
+	Ar << NodeRecords;
+}
+
+bool UGameplaySnapshotSubsystem::Restore(const TArray<uint8>& Data)
+{
+	UWorld* World = GetWorld();
+	const double StartTime = FPlatformTime::Seconds();
+
+	FMemoryReader Ar(Data);
+
+	uint32 Magic = 0;
+	int32 Version = 0;
+	Ar << Magic << Version;
+	if (Magic != GameplaySnapshot::Magic || Version != GameplaySnapshot::Version)
+	{
+		UE_LOG(LogGameplaySnapshot, Warning, TEXT("Snapshot rejected: bad header (version %d)"), Version);
+		return false;
+	}
+
+	bool bHasManager = false;
+	FWaveManagerStateRecord ManagerRecord;
+	TArray<FWaveSpawnerStateRecord> SpawnerRecords;
+	TArray<FEnemyStateRecord> EnemyRecords;
+	TArray<FBorderWallStateRecord> WallRecords;
+	TArray<FNPCNodeStateRecord> NodeRecords;
+	Ar << bHasManager << ManagerRecord << SpawnerRecords << EnemyRecords << WallRecords << NodeRecords;
+
+	if (Ar.IsError())
+	{
+		UE_LOG(LogGameplaySnapshot, Warning, TEXT("Snapshot rejected: truncated data"));
+		return false;
+	}
+
+	// Hits and events from before the restore would land on the restored state next frame
+	if (UEnemyDamageSubsystem* DamageSubsystem = UEnemyDamageSubsystem::Get(World))
+	{
+		DamageSubsystem->DiscardPending();
+	}
+	if (UGameplayEventBus* EventBus = UGameplayEventBus::Get(World))
+	{
+		EventBus->DiscardDeferred();
+	}
+
+	if (AWaveSpawnerManager* Manager = bHasManager ? AWaveSpawnerManager::Get(World) : nullptr)
+	{
+		Manager->RestoreState(ManagerRecord);
+	}
+
+	const TMap<FName, AWaveSpawner*> SpawnersByName = GameplaySnapshot::GatherByName(GameplaySnapshot::GetSpawners(World));
+	for (const FWaveSpawnerStateRecord& Record : SpawnerRecords)
+	{
+		if (AWaveSpawner* Spawner = SpawnersByName.FindRef(Record.Name))
+		{
+			Spawner->RestoreState(Record);
+		}
+	}
+
+	// Walls before enemies, so restored enemies target the right walls
+	const TMap<FName, ABorderWall*> WallsByName = GameplaySnapshot::GatherByName(GameplaySnapshot::GetWalls(World));
+	for (const FBorderWallStateRecord& Record : WallRecords)
+	{
+		if (ABorderWall* Wall = WallsByName.FindRef(Record.Name))
+		{
+			Wall->RestoreState(Record);
+		}
+	}
+
+	const TMap<FName, ANPCNodeSlot*> NodesByName = GameplaySnapshot::GatherByName(GameplaySnapshot::GetNodes(World));
+	const TMap<FName, ANPCCharacter*> NPCsByName = GameplaySnapshot::GatherNPCsByName(World);
+
+	// Every node lets go first, so no node stations an NPC that another node still holds
+	for (const FNPCNodeStateRecord& Record : NodeRecords)
+	{
+		if (ANPCNodeSlot* Node = NodesByName.FindRef(Record.Name))
+		{
+			Node->ReleaseForRestore(NPCsByName.FindRef(Record.OccupantName));
+		}
+	}
+
+	for (const FNPCNodeStateRecord& Record : NodeRecords)
+	{
+		if (ANPCNodeSlot* Node = NodesByName.FindRef(Record.Name))
+		{
+			Node->RestoreState(Record, NPCsByName.FindRef(Record.OccupantName));
+		}
+	}
+
+	RestoreEnemies(EnemyRecords, SpawnersByName);
+
+	UE_LOG(LogGameplaySnapshot, Log, TEXT("Restored snapshot: wave %d, %d enemies in %.2f ms"),
+		ManagerRecord.CurrentWaveCount, EnemyRecords.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+	return true;
+}
+
+void UGameplaySnapshotSubsystem::RestoreEnemies(const TArray<FEnemyStateRecord>& Records, const TMap<FName, AWaveSpawner*>& SpawnersByName)
+{
+	UWorld* World = GetWorld();
+
+	// Live enemies grouped by class, reused before anything new is spawned
+	TMap<UClass*, TArray<AEnemyBase*>> Available;
+	for (AEnemyBase* Enemy : AEnemyManager::GetAllEnemies(GetWorld()))
+	{
+		if (IsValid(Enemy) && Enemy->GetWorld() == World)
+		{
+			Available.FindOrAdd(Enemy->GetClass()).Add(Enemy);
+		}
+	}
+
+	for (const FEnemyStateRecord& Record : Records)
+	{
+		UClass* EnemyClass = FSoftClassPath(Record.ClassPath).TryLoadClass<AEnemyBase>();
+		if (!EnemyClass)
+			continue;
+
+		AWaveSpawner* Spawner = SpawnersByName.FindRef(Record.SpawnerName);
+
+		TArray<AEnemyBase*>* Pool = Available.Find(EnemyClass);
+		if (Pool && Pool->Num() > 0)
+		{
+			Pool->Pop(false)->RestoreState(Record, Spawner);
+			continue;
+		}
+
+		AEnemyBase* Enemy = World->SpawnActorDeferred<AEnemyBase>(EnemyClass, Record.Transform);
+		if (!Enemy)
+			continue;
+
+		Enemy->SetParentSpawner(Spawner);
+		Enemy->FinishSpawning(Record.Transform);
+		AEnemyManager::RegisterEnemy(Enemy);
+		Enemy->RestoreState(Record, Spawner);
+	}
+
+	// Anything not reused wasn't alive in the snapshot
+	for (TPair<UClass*, TArray<AEnemyBase*>>& Pair : Available)
+	{
+		for (AEnemyBase* Enemy : Pair.Value)
+		{
+			Enemy->Destroy();
+		}
+	}
+}
+
+void UGameplaySnapshotSubsystem::CaptureCheckpoint()
+{
+	const double StartTime = FPlatformTime::Seconds();
+	Capture(Checkpoint);
+
+	UE_LOG(LogGameplaySnapshot, Log, TEXT("Captured snapshot: %d bytes in %.2f ms"),
+		Checkpoint.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+bool UGameplaySnapshotSubsystem::RestoreCheckpoint()
+{
+	return HasCheckpoint() && Restore(Checkpoint);
+}
+
+FString UGameplaySnapshotSubsystem::GetSnapshotPath(const FString& Name)
+{
+	return FPaths::ProjectSavedDir() / TEXT("Snapshots") / (Name + TEXT(".snap"));
+}
+
+bool UGameplaySnapshotSubsystem::SaveCheckpointToFile(const FString& Name) const
+{
+	return HasCheckpoint() && FFileHelper::SaveArrayToFile(Checkpoint, *GetSnapshotPath(Name));
+}
+
+bool UGameplaySnapshotSubsystem::LoadCheckpointFromFile(const FString& Name)
+{
+	if (!FFileHelper::LoadFileToArray(Checkpoint, *GetSnapshotPath(Name)))
+	{
+		UE_LOG(LogGameplaySnapshot, Warning, TEXT("No snapshot at %s"), *GetSnapshotPath(Name));
+		return false;
+	}
+	return true;
+}
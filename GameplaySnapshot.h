@@ -0,0 +1,144 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GameplaySnapshot.generated.h"
+
+class AWaveSpawner;
+
+// Per-actor records. Level actors are matched by name on restore, spawned enemies by class.
+
+struct FWaveManagerStateRecord
+{
+	int32 CurrentWaveCount = 0;
+	float HazardTriggerChance = 0.f;
+	int32 MaxHazardsPerAttack = 0;
+	int32 NumSpawnersIncreasedDifficulty = 0;
+	float WaveTimerRemaining = -1.f;
+	float WarningTimerRemaining = -1.f;
+
+	friend FArchive& operator<<(FArchive& Ar, FWaveManagerStateRecord& Record)
+	{
+		Ar << Record.CurrentWaveCount << Record.HazardTriggerChance << Record.MaxHazardsPerAttack
+			<< Record.NumSpawnersIncreasedDifficulty << Record.WaveTimerRemaining << Record.WarningTimerRemaining;
+		return Ar;
+	}
+};
+
+struct FWaveSpawnerStateRecord
+{
+	FName Name;
+	int32 EnemiesToSpawn = 0;
+	int32 EnemiesSpawned = 0;
+	FString EnemyClassPath;
+	float SpawnRadius = 0.f;
+	float SpawnInterval = 0.f;
+	float SpawnTimerRemaining = -1.f;
+
+	friend FArchive& operator<<(FArchive& Ar, FWaveSpawnerStateRecord& Record)
+	{
+		Ar << Record.Name << Record.EnemiesToSpawn << Record.EnemiesSpawned << Record.EnemyClassPath
+			<< Record.SpawnRadius << Record.SpawnInterval << Record.SpawnTimerRemaining;
+		return Ar;
+	}
+};
+
+struct FEnemyStateRecord
+{
+	FString ClassPath;
+	FName SpawnerName;
+	FTransform Transform;
+	float Health = 0.f;
+
+	// Both, so permanent and temporary max health adjustments come back
+	float MaxHealth = 0.f;
+	float CurrentMaxHealth = 0.f;
+
+	int32 EliteCount = 1;
+
+	friend FArchive& operator<<(FArchive& Ar, FEnemyStateRecord& Record)
+	{
+		Ar << Record.ClassPath << Record.SpawnerName << Record.Transform << Record.Health
+			<< Record.MaxHealth << Record.CurrentMaxHealth << Record.EliteCount;
+		return Ar;
+	}
+};
+
+struct FBorderWallStateRecord
+{
+	FName Name;
+	float Health = 0.f;
+
+	friend FArchive& operator<<(FArchive& Ar, FBorderWallStateRecord& Record)
+	{
+		Ar << Record.Name << Record.Health;
+		return Ar;
+	}
+};
+
+struct FNPCNodeStateRecord
+{
+	FName Name;
+	FName OccupantName;
+	float Health = 0.f;
+	uint8 StationState = 0;
+	bool bIsOccupied = false;
+	bool bIsHazardActive = false;
+	bool bHazardScheduled = false;
+	bool bIsDisabled = false;
+	int32 QuantityNeeded = 0;
+	float HazardTimerRemaining = -1.f;
+	float RecoveryTimerRemaining = -1.f;
+	TMap<FName, int32> DeliveredResourceCounts;
+
+	friend FArchive& operator<<(FArchive& Ar, FNPCNodeStateRecord& Record)
+	{
+		Ar << Record.Name << Record.OccupantName << Record.Health << Record.StationState
+			<< Record.bIsOccupied << Record.bIsHazardActive << Record.bHazardScheduled << Record.bIsDisabled
+			<< Record.QuantityNeeded << Record.HazardTimerRemaining << Record.RecoveryTimerRemaining
+			<< Record.DeliveredResourceCounts;
+		return Ar;
+	}
+};
+
+/**
+ * Binary snapshot of the run: wave and hazard progression, spawners, enemies,
+ * walls and nodes, including their pending timers. Restoring works in place on
+ * the loaded level, reusing enemies of the same class where it can, so retries
+ * and benchmark scenarios don't need a level reload.
+ */
+UCLASS()
+class PROJECTSWAGGER_API UGameplaySnapshotSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UGameplaySnapshotSubsystem* Get(const UWorld* World);
+
+	void Capture(TArray<uint8>& OutData) const;
+	bool Restore(const TArray<uint8>& Data);
+
+	// Keeps one snapshot in memory for quick retries
+	UFUNCTION(BlueprintCallable, Category = "Snapshot")
+	void CaptureCheckpoint();
+
+	UFUNCTION(BlueprintCallable, Category = "Snapshot")
+	bool RestoreCheckpoint();
+
+	UFUNCTION(BlueprintPure, Category = "Snapshot")
+	bool HasCheckpoint() const { return Checkpoint.Num() > 0; }
+
+	// Saved/Snapshots/<Name>.snap, e.g. for benchmark scenarios
+	UFUNCTION(BlueprintCallable, Category = "Snapshot")
+	bool SaveCheckpointToFile(const FString& Name) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Snapshot")
+	bool LoadCheckpointFromFile(const FString& Name);
+
+private:
+	static FString GetSnapshotPath(const FString& Name);
+
+	void RestoreEnemies(const TArray<FEnemyStateRecord>& Records, const TMap<FName, AWaveSpawner*>& SpawnersByName);
+
+	TArray<uint8> Checkpoint;
+};
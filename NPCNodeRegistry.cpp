@@ -0,0 +1,117 @@
+#include "NPCs/NPCNodeRegistry.h"
+#include "NPCs/NPCNodeSlot.h"
+#include "GameplayMemoryTags.h"
+
+UNPCNodeRegistry* UNPCNodeRegistry::Get(const UWorld* World)
+{
+	return World ? World->GetSubsystem<UNPCNodeRegistry>() : nullptr;
+}
+
+void UNPCNodeRegistry::RegisterNode(ANPCNodeSlot* Node)
+{
+	LLM_SCOPE_BYTAG(Swagger_Registries);
+
+	if (!Node || Node->RegistrySlot != INDEX_NONE)
+		return;
+
+	int32 Slot;
+	if (FreeSlots.Num() > 0)
+	{
+		Slot = FreeSlots.Pop(false);
+		Nodes[Slot] = Node;
+	}
+	else
+	{
+		Slot = Nodes.Add(Node);
+		OccupiedBits.Add(false);
+		HazardActiveBits.Add(false);
+		HazardScheduledBits.Add(false);
+		DisabledBits.Add(false);
+		EligiblePosition.Add(INDEX_NONE);
+	}
+
+	Node->RegistrySlot = Slot;
+	UpdateNodeState(Node);
+}
+
+void UNPCNodeRegistry::UnregisterNode(ANPCNodeSlot* Node)
+{
+	if (!Node || !Nodes.IsValidIndex(Node->RegistrySlot) || Nodes[Node->RegistrySlot] != Node)
+		return;
+
+	const int32 Slot = Node->RegistrySlot;
+
+	SetEligible(Slot, false);
+	if (OccupiedBits[Slot] && !DisabledBits[Slot])
+	{
+		--NumActiveNodes;
+	}
+
+	OccupiedBits[Slot] = false;
+	HazardActiveBits[Slot] = false;
+	HazardScheduledBits[Slot] = false;
+	DisabledBits[Slot] = false;
+
+	Nodes[Slot] = nullptr;
+	FreeSlots.Add(Slot);
+	Node->RegistrySlot = INDEX_NONE;
+}
+
+void UNPCNodeRegistry::UpdateNodeState(ANPCNodeSlot* Node)
+{
+	if (!Node || !Nodes.IsValidIndex(Node->RegistrySlot))
+		return;
+
+	const int32 Slot = Node->RegistrySlot;
+
+	const bool bWasActive = OccupiedBits[Slot] && !DisabledBits[Slot];
+
+	OccupiedBits[Slot] = Node->bIsOccupied;
+	HazardActiveBits[Slot] = Node->bIsHazardActive;
+	HazardScheduledBits[Slot] = Node->bHazardScheduled;
+	DisabledBits[Slot] = Node->bIsDisabled;
+
+	const bool bIsActive = OccupiedBits[Slot] && !DisabledBits[Slot];
+	NumActiveNodes += static_cast<int32>(bIsActive) - static_cast<int32>(bWasActive);
+
+	SetEligible(Slot, bIsActive && !HazardActiveBits[Slot] && !HazardScheduledBits[Slot]);
+}
+
+void UNPCNodeRegistry::SetEligible(int32 Slot, bool bEligible)
+{
+	const int32 Position = EligiblePosition[Slot];
+	if (bEligible == (Position != INDEX_NONE))
+		return;
+
+	if (bEligible)
+	{
+		EligiblePosition[Slot] = Eligible.Add(Slot);
+	}
+	else
+	{
+		// Swap-remove and patch the moved entry's position
+		const int32 LastSlot = Eligible.Last();
+		Eligible[Position] = LastSlot;
+		EligiblePosition[LastSlot] = Position;
+		Eligible.Pop(false);
+		EligiblePosition[Slot] = INDEX_NONE;
+	}
+}
+
+void UNPCNodeRegistry::PickHazardNodes(int32 MaxCount, TArray<ANPCNodeSlot*, TInlineAllocator<8>>& OutNodes)
+{
+	const int32 NumToPick = FMath::Min(MaxCount, Eligible.Num());
+
+	for (int32 Index = 0; Index < NumToPick; ++Index)
+	{
+		const int32 SwapIndex = FMath::RandRange(Index, Eligible.Num() - 1);
+		if (SwapIndex != Index)
+		{
+			Eligible.Swap(Index, SwapIndex);
+			EligiblePosition[Eligible[Index]] = Index;
+			EligiblePosition[Eligible[SwapIndex]] = SwapIndex;
+		}
+
+		OutNodes.Add(Nodes[Eligible[Index]]);
+	}
+}
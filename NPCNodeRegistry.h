@@ -0,0 +1,57 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "NPCNodeRegistry.generated.h"
+
+class ANPCNodeSlot;
+
+/**
+ * Per-world set of node slots. Node state flags are mirrored into bitsets and the
+ * hazard-eligible set (occupied, not disabled, no hazard active or scheduled) is
+ * kept up to date as nodes change, so hazard picks never touch ineligible nodes.
+ */
+UCLASS()
+class PROJECTSWAGGER_API UNPCNodeRegistry : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UNPCNodeRegistry* Get(const UWorld* World);
+
+	void RegisterNode(ANPCNodeSlot* Node);
+	void UnregisterNode(ANPCNodeSlot* Node);
+
+	// Re-reads the node's flags and updates the bitsets and eligible set
+	void UpdateNodeState(ANPCNodeSlot* Node);
+
+	// Up to MaxCount distinct random eligible nodes, via a partial Fisher-Yates over the eligible set
+	void PickHazardNodes(int32 MaxCount, TArray<ANPCNodeSlot*, TInlineAllocator<8>>& OutNodes);
+
+	// Occupied nodes that aren't disabled
+	int32 GetNumActiveNodes() const { return NumActiveNodes; }
+
+	int32 GetNumHazardEligibleNodes() const { return Eligible.Num(); }
+
+	// Every registered node. Slots freed by unregistered nodes are null.
+	TConstArrayView<TObjectPtr<ANPCNodeSlot>> GetNodes() const { return Nodes; }
+
+private:
+	void SetEligible(int32 Slot, bool bEligible);
+
+	UPROPERTY()
+	TArray<TObjectPtr<ANPCNodeSlot>> Nodes;
+
+	TArray<int32> FreeSlots;
+
+	TBitArray<> OccupiedBits;
+	TBitArray<> HazardActiveBits;
+	TBitArray<> HazardScheduledBits;
+	TBitArray<> DisabledBits;
+
+	// Dense list of eligible slots, and each slot's position in it (INDEX_NONE if not eligible)
+	TArray<int32> Eligible;
+	TArray<int32> EligiblePosition;
+
+	int32 NumActiveNodes = 0;
+};
@@ -1,5 +1,7 @@
 #include "NPCs/NPCNodeSlot.h"
 
+#include "BrainComponent.h"
+#include "BehaviorTree/BehaviorTreeComponent.h"
 #include "BehaviorTree/BlackboardComponent.h"
 #include "Components/HealthComponent.h"
 #include "Components/SphereComponent.h"
@@ -11,15 +13,18 @@
 #include "Components/WidgetComponent.h"
 #include "NPCs/NPCAIController.h"
 #include "NPCs/NPCManager.h"
+#include "NPCs/NPCNodeRegistry.h"
 #include "Player/Inventory/InventoryComponent.h"
+#include "Player/Inventory/ResourceTagIndex.h"
 #include "UI/ProjectSwaggerHUD.h"
+#include "GameplaySnapshot.h"
+#include "GameplayMemoryTags.h"
 
 
-unsigned int ANPCNodeSlot::NumActiveNodes = 0;
-
 void ANPCNodeSlot::StartHazardTimer()
 {
 	bHazardScheduled = true;
+	NotifyStateChanged();
 	float Delay = Hazard.GetNextNeedDelay();
 	GetWorld()->GetTimerManager().SetTimer(
 		Hazard.ResourceTimerHandle,
@@ -34,7 +39,10 @@ void ANPCNodeSlot::TriggerHazard()
 {
 	bHazardScheduled = false;
 	if (Hazard.CurrentQuantityNeeded > 0 )
+	{
+		NotifyStateChanged();
 		return;
+	}
 	
 	Hazard.CurrentQuantityNeeded = Hazard.GetRandomQuantity();
 
@@ -45,21 +53,157 @@ void ANPCNodeSlot::TriggerHazard()
 	);
 
 	bIsHazardActive = true;
+	NotifyStateChanged();
 	GEngine->AddOnScreenDebugMessage(-1, 60.f, FColor::Orange, Msg);
 
+	GetWorldTimerManager().ClearTimer(RecoveryTimerHandle);
+	SetStationState(ENPCStationState::Hazard);
+}
+
+void ANPCNodeSlot::SetStationState(ENPCStationState NewState)
+{
+	if (StationState == NewState)
+		return;
+
+	StationState = NewState;
+
+	RunLegacyStationTree(NewState);
+
+	// The follow tree is paused while stationed, but its blackboard stays live for anim/BP reads
+	if (OccupantNPC)
+	{
+		if (AAIController* AI = Cast<AAIController>(OccupantNPC->GetController()))
+		{
+			if (UBlackboardComponent* BB = AI->GetBlackboardComponent())
+			{
+				BB->SetValueAsEnum(StationStateKey, static_cast<uint8>(NewState));
+			}
+		}
+	}
+
+	OnStationStateChanged(NewState);
+}
+
+void ANPCNodeSlot::GetPreloadAssets(TArray<FSoftObjectPath>& OutPaths) const
+{
+	for (const TSoftObjectPtr<UBehaviorTree>* Tree : { &BehaviorTreeAsset, &Hazard.HazardBehaviorTree, &NPCOldBehaviorTree })
+	{
+		if (!Tree->IsNull())
+		{
+			OutPaths.AddUnique(Tree->ToSoftObjectPath());
+		}
+	}
+}
+
+UBehaviorTree* ANPCNodeSlot::GetLegacyStationTree(ENPCStationState State) const
+{
+	// Already resident from the wave manager's preload; only a node placed after it loads here
+	switch (State)
+	{
+	case ENPCStationState::Working:
+	case ENPCStationState::Recovering:
+		return BehaviorTreeAsset.LoadSynchronous();
+
+	case ENPCStationState::Hazard:
+		return !Hazard.HazardBehaviorTree.IsNull() ? Hazard.HazardBehaviorTree.LoadSynchronous() : BehaviorTreeAsset.LoadSynchronous();
+
+	default:
+		return nullptr;
+	}
+}
+
+void ANPCNodeSlot::RunLegacyStationTree(ENPCStationState NewState)
+{
+	ANPCAIController* AIController = OccupantNPC ? Cast<ANPCAIController>(OccupantNPC->GetController()) : nullptr;
+	if (!AIController)
+		return;
+
+	UBehaviorTree* Tree = GetLegacyStationTree(NewState);
+	if (!Tree)
+	{
+		if (bRunningLegacyTree)
+		{
+			bRunningLegacyTree = false;
+			AIController->RunBehaviorTree(NPCOldBehaviorTree.LoadSynchronous());
+
+			// Still stationed: the follow tree waits paused again, as in AssignOccupant
+			if (NewState != ENPCStationState::Unassigned)
+			{
+				AIController->BrainComponent->PauseLogic(TEXT("Stationed at node."));
+			}
+		}
+		return;
+	}
+
+	if (AIController->BehaviorTreeComponent->GetCurrentTree() == Tree)
+		return;
+
+	if (!bRunningLegacyTree)
+	{
+		NPCOldBehaviorTree = AIController->BehaviorTreeComponent->GetCurrentTree();
+		bRunningLegacyTree = true;
+
+		// Paused by AssignOccupant, a paused brain wouldn't run the new tree
+		if (AIController->BrainComponent->IsPaused())
+		{
+			AIController->BrainComponent->ResumeLogic(TEXT("Running legacy station tree."));
+		}
+	}
+
+	AIController->RunBehaviorTree(Tree);
+
+	// A different blackboard asset starts empty
+	if (UBlackboardComponent* BB = AIController->GetBlackboardComponent())
+	{
+		BB->SetValueAsObject("AssignedNode", this);
+	}
+}
+
+void ANPCNodeSlot::FinishRecovery()
+{
+	if (StationState == ENPCStationState::Recovering)
+	{
+		SetStationState(ENPCStationState::Working);
+	}
+}
+
+void ANPCNodeSlot::ReleaseOccupant(AProjectSwaggerCharacter* FollowTarget, const TCHAR* Reason)
+{
+	GetWorldTimerManager().ClearTimer(Hazard.ResourceTimerHandle);
+	GetWorldTimerManager().ClearTimer(RecoveryTimerHandle);
+
+	// Puts the follow tree back if a legacy station tree replaced it
+	const bool bWasRunningLegacyTree = bRunningLegacyTree;
+	SetStationState(ENPCStationState::Unassigned);
+
+	if (!OccupantNPC)
+		return;
+
 	if (ANPCAIController* AIController = Cast<ANPCAIController>(OccupantNPC->GetController()))
 	{
-		AIController->BehaviorTreeComponent->StopLogic(TEXT("NPC needs resources!"));
-		AIController->RunBehaviorTree(Hazard.HazardBehaviorTree);
+		AIController->StopMovement();
+
+		if (UBlackboardComponent* BB = AIController->GetBlackboardComponent())
+		{
+			BB->ClearValue("AssignedNode");
+		}
+
+		// Pick the follow tree back up where it was paused, with its blackboard intact
+		if (AIController->BrainComponent && !bWasRunningLegacyTree)
+		{
+			AIController->BrainComponent->ResumeLogic(Reason);
+		}
 	}
+
+	OccupantNPC->SetToNode(nullptr);
+	OccupantNPC->FollowPlayer(FollowTarget);
+	OccupantNPC = nullptr;
 }
 
 ANPCNodeSlot::ANPCNodeSlot()
 {
 	PrimaryActorTick.bCanEverTick = true;
 
-	NumActiveNodes = 0;
-
 	NodeMeshComponent = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("NodeMesh"));
 	SetRootComponent(NodeMeshComponent);
 
@@ -70,11 +214,6 @@ ANPCNodeSlot::ANPCNodeSlot()
 	}
 	
 	HealthComponent = CreateDefaultSubobject<UHealthComponent>(TEXT("HealthComponent"));
-
-	// Inventory Component
-	InventoryComponent = CreateDefaultSubobject<UInventoryComponent>(TEXT("PlayerInventory"));
-	InventoryComponent->SetCapacity(10000);
-
 	
 	InteractionSphere = CreateDefaultSubobject<USphereComponent>(TEXT("InteractionSphere"));
 	InteractionSphere->SetupAttachment(RootComponent);
@@ -102,50 +241,47 @@ ANPCNodeSlot::ANPCNodeSlot()
 	DetectionSphere->SetGenerateOverlapEvents(true);
 }
 
-bool ANPCNodeSlot::HasRequiredResources(const AProjectSwaggerCharacter* Player, TArray<AResourceBase*>& ItemsToRemove) const
+void ANPCNodeSlot::IndexInventory(const AProjectSwaggerCharacter* Player, FResourceTagIndex& OutInventory)
 {
-	if (!Player || !Player->GetInventory())
-		return false;
-
-	TArray<AResourceBase*> Inventory = Player->GetInventory()->GetInventoryContents();
-
-	int32 TotalFound = 0;
-
-	for (int32 i = 0; i < Inventory.Num(); ++i)
+	OutInventory.Reset();
+	if (Player && Player->GetInventory())
 	{
-		AResourceBase* Item = Inventory[i];
-		
-		if (!Item) continue;
+		OutInventory.Append(Player->GetInventory()->GetInventoryContents());
+	}
+}
 
-		if (Item->GetResourceTag().MatchesTagExact(Hazard.ResourceTag))
-		{
-			++TotalFound;
-			ItemsToRemove.Add(Item);
-			if (Item->GetResourceTag().MatchesTagExact(Hazard.HealingResourceTag))
-			{
-				//DO NOT USE HEAL FUNCTION-- Node can heal from 0, so it's a weird edge case for the health component
-				HealthComponent->CurrentHealth =  FMath::Clamp(
-				HealthComponent->CurrentHealth + Hazard.HealthHealedPerResource,0.0f, HealthComponent->MaxHealth);
-			}
+bool ANPCNodeSlot::HasRequiredResources(const FResourceTagIndex& Inventory, TFrameArray<AResourceBase*>& ItemsToRemove) const
+{
+	if (Inventory.Count(Hazard.ResourceTag) < Hazard.CurrentQuantityNeeded)
+		return false;
 
-		}
+	TConstArrayView<AResourceBase*> Items = Inventory.GetItems(Hazard.ResourceTag);
+	ItemsToRemove.Append(Items.GetData(), Hazard.CurrentQuantityNeeded);
 
-		if (TotalFound >= Hazard.CurrentQuantityNeeded)
-			return true;
+	if (Hazard.ResourceTag.MatchesTagExact(Hazard.HealingResourceTag))
+	{
+		//DO NOT USE HEAL FUNCTION-- Node can heal from 0, so it's a weird edge case for the health component
+		HealthComponent->CurrentHealth =  FMath::Clamp(
+		HealthComponent->CurrentHealth + Hazard.HealthHealedPerResource * Hazard.CurrentQuantityNeeded,0.0f, HealthComponent->MaxHealth);
 	}
 
-	return false;
+	return true;
 }
 
 bool ANPCNodeSlot::TakeHealingResources(AProjectSwaggerCharacter* Player)
 {
-	if (!Player || !Player->GetInventory())
-		return false;
-
-	TArray<AResourceBase*> Inventory = Player->GetInventory()->GetInventoryContents();
+	FResourceTagIndex Inventory;
+	IndexInventory(Player, Inventory);
+	return TakeHealingResourcesFrom(Player, Inventory);
+}
 
+bool ANPCNodeSlot::TakeHealingResourcesFrom(AProjectSwaggerCharacter* Player, FResourceTagIndex& Inventory)
+{
+	if (!Player)
+		return false;
 
-	for (int32 i = 0; i < Inventory.Num(); ++i)
+	// Walk the bucket from the back: removing the last item never moves one we haven't visited
+	for (int32 i = Inventory.Count(Hazard.HealingResourceTag) - 1; i >= 0; --i)
 	{
 		if (HealthComponent->CurrentHealth >= HealthComponent->MaxHealth)
 		{
@@ -153,34 +289,47 @@ bool ANPCNodeSlot::TakeHealingResources(AProjectSwaggerCharacter* Player)
 FString::Printf(TEXT("Health is full; cannot accept any more health resources.")));
 			return true;
 		}
-		
-		AResourceBase* Item = Inventory[i];
+
+		TConstArrayView<AResourceBase*> Items = Inventory.GetItems(Hazard.HealingResourceTag);
+		if (!Items.IsValidIndex(i))
+			continue;
+
+		AResourceBase* Item = Items[i];
 		
 		if (!Item) continue;
 
-		if (Item->GetResourceTag().MatchesTagExact(Hazard.HealingResourceTag))
+		if (bIsDisabled)
 		{
 			bIsDisabled = false;
-			
-			Player->RemoveCarriedResource(Item);
-			Item->IsCarried = true;
-			Item->CarryingPlayer = this;
-			Item->SetActorEnableCollision(false);
-			Item->SetActorTickEnabled(true);
-			Item->SetActorLocation(GetActorLocation());
-			InventoryComponent->AddItem(Item);
-			
-			//DO NOT USE HEAL FUNCTION-- Node can heal from 0, so it's a weird edge case for the health component
-			HealthComponent->CurrentHealth =  FMath::Clamp(
-			HealthComponent->CurrentHealth + Hazard.HealthHealedPerResource,0.0f, HealthComponent->MaxHealth);
-			
-			GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Green,
-	FString::Printf(TEXT("Resource fulfilled %f health. Current health is now: %f."), Hazard.HealthHealedPerResource, HealthComponent->CurrentHealth));
+			NotifyStateChanged();
 		}
+		
+		Inventory.Remove(Item);
+		ConsumeResource(Player, Item);
+		
+		//DO NOT USE HEAL FUNCTION-- Node can heal from 0, so it's a weird edge case for the health component
+		HealthComponent->CurrentHealth =  FMath::Clamp(
+		HealthComponent->CurrentHealth + Hazard.HealthHealedPerResource,0.0f, HealthComponent->MaxHealth);
+		
+		GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Green,
+	FString::Printf(TEXT("Resource fulfilled %f health. Current health is now: %f."), Hazard.HealthHealedPerResource, HealthComponent->CurrentHealth));
 	}
 
 	return false;
 }
+void ANPCNodeSlot::ConsumeResource(AProjectSwaggerCharacter* Player, AResourceBase* Resource)
+{
+	// The soak commandlet hands over resources with no player carrying them
+	if (Player)
+	{
+		Player->RemoveCarriedResource(Resource);
+	}
+	++DeliveredResourceCounts.FindOrAdd(Resource->GetResourceTag());
+
+	// Nothing reads the delivered actor again, so don't keep it alive and ticking on the node
+	Resource->Destroy();
+}
+
 void ANPCNodeSlot::OnResourceDelivered(FGameplayTag& ResourceType, int32 Quantity)
 {
 	if (!ResourceType.MatchesTagExact(Hazard.ResourceTag)) return;
@@ -193,15 +342,21 @@ void ANPCNodeSlot::OnResourceDelivered(FGameplayTag& ResourceType, int32 Quantit
 		GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Green,
 			FString::Printf(TEXT("Resource fulfilled for %s. NPC resuming."), *GetName()));
 
-		// Resume AI
+		// Resume work after a short recovery
 		if (OccupantNPC)
 		{
-			if (AAIController* AI = Cast<AAIController>(OccupantNPC->GetController()))
+			if (RecoveryDuration > 0.f)
 			{
-				AI->RunBehaviorTree(BehaviorTreeAsset);
+				SetStationState(ENPCStationState::Recovering);
+				GetWorldTimerManager().SetTimer(RecoveryTimerHandle, this, &ANPCNodeSlot::FinishRecovery, RecoveryDuration, false);
+			}
+			else
+			{
+				SetStationState(ENPCStationState::Working);
 			}
 		}
 		bIsHazardActive = false;
+		NotifyStateChanged();
 	}
 	else
 	{
@@ -241,11 +396,17 @@ void ANPCNodeSlot::OnPlayerOverlap(UPrimitiveComponent* OverlappedComp, AActor*
 	AProjectSwaggerCharacter* Player = Cast<AProjectSwaggerCharacter>(OtherActor);
 	if (!Player)
 		return;
+
+	GAMEPLAY_HEAP_SCOPE();
+	LLM_SCOPE_BYTAG(Swagger_NodeInventory);
+
+	FResourceTagIndex Inventory;
+	IndexInventory(Player, Inventory);
 	
 	//if the node needs healing, always accepting health resource
 	if (HealthComponent->CurrentHealth < HealthComponent->MaxHealth && !bIsHazardActive)
 	{
-		TakeHealingResources(Player);
+		TakeHealingResourcesFrom(Player, Inventory);
 	}
 	
 	if (Hazard.CurrentQuantityNeeded <= 0)
@@ -255,20 +416,13 @@ void ANPCNodeSlot::OnPlayerOverlap(UPrimitiveComponent* OverlappedComp, AActor*
 
 	
 
-	TArray<AResourceBase*> ItemsToRemove;
-	if (HasRequiredResources(Player, ItemsToRemove))
+	TFrameArray<AResourceBase*> ItemsToRemove;
+	if (HasRequiredResources(Inventory, ItemsToRemove))
 	{
-		TArray<AResourceBase*> Inventory = Player->GetInventory()->GetInventoryContents();
 		for (auto Resource : ItemsToRemove)
 		{
 			//TODO: Make the resource lerp to the node, like the resource tank
-			Player->RemoveCarriedResource(Resource);
-			Resource->IsCarried = true;
-			Resource->CarryingPlayer = this;
-			Resource->SetActorEnableCollision(false);
-			Resource->SetActorTickEnabled(true);
-			Resource->SetActorLocation(GetActorLocation());
-			InventoryComponent->AddItem(Resource);
+			ConsumeResource(Player, Resource);
 		}
 		
 		OnResourceDelivered(Hazard.ResourceTag, Hazard.CurrentQuantityNeeded);
@@ -288,6 +442,12 @@ void ANPCNodeSlot::OnPlayerOverlap(UPrimitiveComponent* OverlappedComp, AActor*
 void ANPCNodeSlot::BeginPlay()
 {
 	Super::BeginPlay();
+
+	if (UNPCNodeRegistry* Registry = UNPCNodeRegistry::Get(GetWorld()))
+	{
+		Registry->RegisterNode(this);
+	}
+
 	
 	DetectionSphere->OnComponentBeginOverlap.AddDynamic(this, &ANPCNodeSlot::OnEnemyOverlap);
 	InteractionSphere->OnComponentBeginOverlap.AddDynamic(this, &ANPCNodeSlot::OnPlayerOverlap);
@@ -299,12 +459,31 @@ void ANPCNodeSlot::BeginPlay()
 	}
 }
 
+void ANPCNodeSlot::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UNPCNodeRegistry* Registry = UNPCNodeRegistry::Get(GetWorld()))
+	{
+		Registry->UnregisterNode(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ANPCNodeSlot::NotifyStateChanged()
+{
+	if (UNPCNodeRegistry* Registry = UNPCNodeRegistry::Get(GetWorld()))
+	{
+		Registry->UpdateNodeState(this);
+	}
+}
+
 void ANPCNodeSlot::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 	//DrawDebugSphere(GetWorld(), GetActorLocation(), InteractionSphere->GetScaledSphereRadius(), 16, FColor::Green);
 
-	if (AProjectSwaggerHUD* GameHUD = Cast<AProjectSwaggerHUD>(GetWorld()->GetFirstPlayerController()->GetHUD()))
+	const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	if (AProjectSwaggerHUD* GameHUD = PlayerController ? Cast<AProjectSwaggerHUD>(PlayerController->GetHUD()) : nullptr)
 	{
 		if (GameHUD->IsInUI())
 		{
@@ -313,6 +492,11 @@ void ANPCNodeSlot::Tick(float DeltaTime)
 			{
 				GetWorldTimerManager().PauseTimer(Hazard.ResourceTimerHandle);	
 			}
+
+			if (!GetWorldTimerManager().IsTimerPaused(RecoveryTimerHandle))
+			{
+				GetWorldTimerManager().PauseTimer(RecoveryTimerHandle);
+			}
 		}
 		else
 		{
@@ -321,6 +505,11 @@ void ANPCNodeSlot::Tick(float DeltaTime)
 			{
 				GetWorldTimerManager().UnPauseTimer(Hazard.ResourceTimerHandle);
 			}
+
+			if (GetWorldTimerManager().IsTimerPaused(RecoveryTimerHandle))
+			{
+				GetWorldTimerManager().UnPauseTimer(RecoveryTimerHandle);
+			}
 		}
 	}
 }
@@ -362,26 +551,14 @@ void ANPCNodeSlot::OnDeath()
 	bIsHazardActive = false;
 	bHazardScheduled = false;
 	Hazard.CurrentQuantityNeeded = 0;
-	NumActiveNodes--;
 	bIsOccupied = false;
+	NotifyStateChanged();
 	OnDisabled();
 	
-	if (!OccupantNPC)
-		return;
-	
-	if (ANPCAIController* AIController = Cast<ANPCAIController>(OccupantNPC->GetController()))
-	{
-		AIController->BrainComponent->StopLogic(TEXT("Node has been destroyed."));
-		AIController->RunBehaviorTree(NPCOldBehaviorTree);
-		OccupantNPC->SetToNode(nullptr);
-		
-		AProjectSwaggerCharacter* Player = Cast<AProjectSwaggerCharacter>(
+	AProjectSwaggerCharacter* Player = Cast<AProjectSwaggerCharacter>(
 	UGameplayStatics::GetPlayerCharacter(GetWorld(), 0));
-	
-		OccupantNPC->FollowPlayer(Player);
-		GetWorld()->GetTimerManager().ClearTimer(Hazard.ResourceTimerHandle);
-		OccupantNPC = nullptr;
-	}
+
+	ReleaseOccupant(Player, TEXT("Node has been destroyed."));
 }
 
 void ANPCNodeSlot::Interact(AProjectSwaggerCharacter* Player)
@@ -394,57 +571,134 @@ void ANPCNodeSlot::Interact(AProjectSwaggerCharacter* Player)
 	if (bIsOccupied)
 	{
 		//we are just unassigning the current occupant
-		if (ANPCAIController* AIController = Cast<ANPCAIController>(OccupantNPC->GetController()))
+		if (OccupantNPC)
 		{
-			AIController->BehaviorTreeComponent->StopLogic(TEXT("Unassigning NPC from slot."));
-
-			AIController->RunBehaviorTree(NPCOldBehaviorTree);
-			// Set NPC to follow player
-			OccupantNPC->SetToNode(nullptr);
 			OccupantNPC->SetActorLocation(Player->GetActorLocation());
-			OccupantNPC->FollowPlayer(Player);
-			
-			//TODO: reset node stats to what they were before NPC was equipped
-
-			GetWorld()->GetTimerManager().ClearTimer(Hazard.ResourceTimerHandle);
 		}
+
+		// Set NPC to follow player
+		ReleaseOccupant(Player, TEXT("Unassigning NPC from slot."));
+		
+		//TODO: reset node stats to what they were before NPC was equipped
+
 		bIsOccupied = false;
-		NumActiveNodes--;
+		NotifyStateChanged();
 		return;
 	}
  	if (ANPCManager* NPCMgr = ANPCManager::Get(GetWorld()))
 	{
 		//TODO: update this to allow player to choose which NPC to equip rather than random selection
  		
-		OccupantNPC = NPCMgr->GetRandomFollowerNPC();
- 		if (!OccupantNPC)
+		ANPCCharacter* NPC = NPCMgr->GetRandomFollowerNPC();
+ 		if (!NPC)
  		{
  			FString NPCWarning = FString::Printf(TEXT("No NPCs recruited!"));
  			GEngine->AddOnScreenDebugMessage(-1, 2.f, FColor::Green, NPCWarning);
  			return;
  		}
- 		OccupantNPC->SetToNode(this);
- 		OccupantNPC->FollowPlayer(nullptr);
- 		bIsOccupied = true;
- 		NumActiveNodes++;
  		//TODO: update stats based on NPC values, make it impossible to talk to/recruit NPC
 
-		//start BHT
-		if (ANPCAIController* AIController = Cast<ANPCAIController>(OccupantNPC->GetController()))
-		{
+		AssignOccupant(NPC);
+	}
+}
 
-			NPCOldBehaviorTree = AIController->BehaviorTreeComponent->GetCurrentTree();
-			AIController->ClearFollowTarget();
-			if (BehaviorTreeAsset)
-			{
-				AIController->RunBehaviorTree(BehaviorTreeAsset);
+void ANPCNodeSlot::AssignOccupant(ANPCCharacter* NPC)
+{
+	OccupantNPC = NPC;
+	OccupantNPC->SetToNode(this);
+	OccupantNPC->FollowPlayer(nullptr);
+	bIsOccupied = true;
+	NotifyStateChanged();
 
-				if (UBlackboardComponent* BB = AIController->GetBlackboardComponent())
-				{
-					//write whatever data is needed to the AI can operate on the node
-					BB->SetValueAsObject("AssignedNode", this); // Expose the node actor
-				}
-			}
+	// Stationed NPCs run the native station logic. The follow tree is paused, not torn down.
+	if (ANPCAIController* AIController = Cast<ANPCAIController>(OccupantNPC->GetController()))
+	{
+		AIController->ClearFollowTarget();
+		if (AIController->BrainComponent)
+		{
+			AIController->BrainComponent->PauseLogic(TEXT("Stationed at node."));
+		}
+
+		if (UBlackboardComponent* BB = AIController->GetBlackboardComponent())
+		{
+			//write whatever data is needed to the AI can operate on the node
+			BB->SetValueAsObject("AssignedNode", this); // Expose the node actor
 		}
+
+		AIController->MoveToActor(this, StationAcceptanceRadius);
+	}
+
+	SetStationState(ENPCStationState::Working);
+}
+
+void ANPCNodeSlot::SaveState(FNPCNodeStateRecord& OutRecord) const
+{
+	OutRecord.Name = GetFName();
+	OutRecord.OccupantName = OccupantNPC ? OccupantNPC->GetFName() : NAME_None;
+	OutRecord.Health = HealthComponent ? HealthComponent->CurrentHealth : 0.f;
+	OutRecord.StationState = static_cast<uint8>(StationState);
+	OutRecord.bIsOccupied = bIsOccupied;
+	OutRecord.bIsHazardActive = bIsHazardActive;
+	OutRecord.bHazardScheduled = bHazardScheduled;
+	OutRecord.bIsDisabled = bIsDisabled;
+	OutRecord.QuantityNeeded = Hazard.CurrentQuantityNeeded;
+	OutRecord.HazardTimerRemaining = GetWorldTimerManager().GetTimerRemaining(Hazard.ResourceTimerHandle);
+	OutRecord.RecoveryTimerRemaining = GetWorldTimerManager().GetTimerRemaining(RecoveryTimerHandle);
+
+	OutRecord.DeliveredResourceCounts.Reset();
+	for (const TPair<FGameplayTag, int32>& Pair : DeliveredResourceCounts)
+	{
+		OutRecord.DeliveredResourceCounts.Add(Pair.Key.GetTagName(), Pair.Value);
 	}
 }
+
+void ANPCNodeSlot::ReleaseForRestore(ANPCCharacter* Occupant)
+{
+	if (OccupantNPC && OccupantNPC != Occupant)
+	{
+		ReleaseOccupant(Cast<AProjectSwaggerCharacter>(UGameplayStatics::GetPlayerCharacter(GetWorld(), 0)), TEXT("Restoring snapshot."));
+	}
+}
+
+void ANPCNodeSlot::RestoreState(const FNPCNodeStateRecord& Record, ANPCCharacter* Occupant)
+{
+	// Assign first, it touches the flags and timers below. Every node has released in ReleaseForRestore by now.
+	ReleaseForRestore(Occupant);
+	if (Occupant && OccupantNPC != Occupant)
+	{
+		AssignOccupant(Occupant);
+	}
+
+	if (HealthComponent)
+	{
+		HealthComponent->CurrentHealth = Record.Health;
+		OnHealthChanged(HealthComponent->CurrentHealth, HealthComponent->CurrentMaxHealth);
+	}
+
+	bIsOccupied = Record.bIsOccupied && OccupantNPC != nullptr;
+	bIsHazardActive = Record.bIsHazardActive;
+	bHazardScheduled = Record.bHazardScheduled;
+	bIsDisabled = Record.bIsDisabled;
+	Hazard.CurrentQuantityNeeded = Record.QuantityNeeded;
+
+	DeliveredResourceCounts.Reset();
+	for (const TPair<FName, int32>& Pair : Record.DeliveredResourceCounts)
+	{
+		DeliveredResourceCounts.Add(FGameplayTag::RequestGameplayTag(Pair.Key, false), Pair.Value);
+	}
+
+	FTimerManager& TimerManager = GetWorldTimerManager();
+	TimerManager.ClearTimer(Hazard.ResourceTimerHandle);
+	TimerManager.ClearTimer(RecoveryTimerHandle);
+	if (Record.HazardTimerRemaining > 0.f)
+	{
+		TimerManager.SetTimer(Hazard.ResourceTimerHandle, this, &ANPCNodeSlot::TriggerHazard, Record.HazardTimerRemaining, false);
+	}
+	if (Record.RecoveryTimerRemaining > 0.f)
+	{
+		TimerManager.SetTimer(RecoveryTimerHandle, this, &ANPCNodeSlot::FinishRecovery, Record.RecoveryTimerRemaining, false);
+	}
+
+	SetStationState(OccupantNPC ? static_cast<ENPCStationState>(Record.StationState) : ENPCStationState::Unassigned);
+	NotifyStateChanged();
+}
@@ -9,11 +9,14 @@
 #include "BehaviorTree/BehaviorTree.h"
 #include "Interactables/Resources/ResourceBase.h"
 #include "Interfaces/InteractionInterface.h"
+#include "GameplayFrameArena.h"
 #include "NPCNodeSlot.generated.h"
 
 
 class UHealthComponent;
 class UWidgetComponent;
+struct FNPCNodeStateRecord;
+struct FResourceTagIndex;
 
 
 //Types of nodes
@@ -31,6 +34,16 @@ enum class ENPCNodeType : uint8
 };
 */
 
+// What a stationed NPC is doing. Driven natively by the node; the NPC's behavior tree only runs while following.
+UENUM(BlueprintType)
+enum class ENPCStationState : uint8
+{
+	Unassigned,
+	Working,
+	Hazard,
+	Recovering
+};
+
 USTRUCT(BlueprintType)
 struct FNPCHazard
 {
@@ -50,8 +63,8 @@ struct FNPCHazard
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Need")
 	FGameplayTag ResourceTag;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hazard")
-	TObjectPtr<UBehaviorTree> HazardBehaviorTree = nullptr;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hazard", meta=(ToolTip="Legacy: run while the hazard is active. Leave empty once the node's OnStationStateChanged handles hazards."))
+	TSoftObjectPtr<UBehaviorTree> HazardBehaviorTree;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Recovery")
 	FGameplayTag HealingResourceTag;
@@ -108,6 +121,17 @@ public:
 	void ApplySimpleDamage(float DamageAmount, AActor* DamageCauser);
 
 
+	void SaveState(FNPCNodeStateRecord& OutRecord) const;
+
+	// Restores health, flags, hazard progress and timers. Occupant may be null.
+	// First pass of a restore: releases the current occupant unless it's the one being restored
+	void ReleaseForRestore(ANPCCharacter* Occupant);
+	void RestoreState(const FNPCNodeStateRecord& Record, ANPCCharacter* Occupant);
+
+	// Pushes the state flags to the node registry. Call after changing them from Blueprint.
+	UFUNCTION(BlueprintCallable, Category = "Properties")
+	void NotifyStateChanged();
+
 	UFUNCTION(BlueprintNativeEvent, Category = "Interaction")
 	void OnPlayerEnter(AActor* OtherActor);
 	virtual void OnPlayerEnter_Implementation(AActor* OtherActor);
@@ -119,21 +143,57 @@ public:
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	virtual void Interact(AProjectSwaggerCharacter* Player) override;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Properties")
 	UStaticMeshComponent* NodeMeshComponent = nullptr;
 
-	UPROPERTY()
-	TObjectPtr<UBehaviorTree> NPCOldBehaviorTree { nullptr };
-	
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "NPC")
+	ENPCStationState StationState = ENPCStationState::Unassigned;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "NPC", meta=(ToolTip="Time the NPC spends recovering after a hazard is resolved."))
+	float RecoveryDuration = 2.0f;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "NPC")
-	TObjectPtr<UBehaviorTree> BehaviorTreeAsset = nullptr;
+	float StationAcceptanceRadius = 50.0f;
+
+	// Blackboard enum key the station state is mirrored to
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "NPC")
+	FName StationStateKey = "StationState";
+
+	// Legacy station tree, kept until stations are moved to OnStationStateChanged. While set, the
+	// occupant runs it instead of pausing its follow tree, and the hazard tree while a hazard is up.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "NPC", meta=(ToolTip="Legacy: run while stationed. Leave empty to use the native station state machine."))
+	TSoftObjectPtr<UBehaviorTree> BehaviorTreeAsset;
+
+	// Occupant's follow tree, put back on release if a legacy tree replaced it
+	UPROPERTY()
+	TSoftObjectPtr<UBehaviorTree> NPCOldBehaviorTree;
 	
 	UPROPERTY(EditAnywhere, Category = "NPC")
 	FNPCHazard Hazard;
 
+	UFUNCTION(BlueprintImplementableEvent, Category = "NPC")
+	void OnStationStateChanged(ENPCStationState NewState);
+
+	void SetStationState(ENPCStationState NewState);
+	void FinishRecovery();
+
+	// Legacy tree for the state, or null where the native state machine alone drives the NPC
+	UBehaviorTree* GetLegacyStationTree(ENPCStationState State) const;
+	void RunLegacyStationTree(ENPCStationState NewState);
+	bool bRunningLegacyTree = false;
+
+	// Hands the occupant back to its follow behavior tree
+	void ReleaseOccupant(AProjectSwaggerCharacter* FollowTarget, const TCHAR* Reason);
+
+	// Stations the NPC here, pausing its follow tree
+	void AssignOccupant(ANPCCharacter* NPC);
+
+	FTimerHandle RecoveryTimerHandle;
+
 	// NPC currently manning this station
 	UPROPERTY(BlueprintReadOnly, Category = "NPC")
 	ANPCCharacter* OccupantNPC = nullptr;
@@ -144,8 +204,12 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (BindWidget), Category = "Properties")
 	UWidgetComponent* HealthBarWidget;
 	
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Properties")
-	UInventoryComponent* InventoryComponent = nullptr;
+	// Resources delivered to this node, by tag. The resource actors themselves are destroyed on delivery.
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Properties")
+	TMap<FGameplayTag, int32> DeliveredResourceCounts;
+
+	UFUNCTION(BlueprintPure, Category = "Properties")
+	int32 GetDeliveredResourceCount(FGameplayTag ResourceTag) const { return DeliveredResourceCounts.FindRef(ResourceTag); }
 
 	//Hazards and resource needs
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
@@ -170,12 +234,20 @@ protected:
 	UFUNCTION()
 	void OnResourceDelivered(FGameplayTag& ResourceType, int32 Quantity);
 
-	UFUNCTION()
-	bool HasRequiredResources(const AProjectSwaggerCharacter* Player, TArray<AResourceBase*>& ItemsToRemove) const;
+	bool HasRequiredResources(const FResourceTagIndex& Inventory, TFrameArray<AResourceBase*>& ItemsToRemove) const;
 
 	UFUNCTION()
 	bool TakeHealingResources(AProjectSwaggerCharacter* Player);
 
+	// Takes healing resources listed in the player's index, removing them from it as they're consumed
+	bool TakeHealingResourcesFrom(AProjectSwaggerCharacter* Player, FResourceTagIndex& Inventory);
+
+	// One pass over the player's inventory into frame arena storage, shared by every check in an overlap
+	static void IndexInventory(const AProjectSwaggerCharacter* Player, FResourceTagIndex& OutInventory);
+
+	// Takes the resource from the player if there is one, counts it and retires the actor
+	void ConsumeResource(AProjectSwaggerCharacter* Player, AResourceBase* Resource);
+
 
 	UFUNCTION(BlueprintImplementableEvent, Category = "State")
 	void OnDisabled();
@@ -183,6 +255,9 @@ protected:
 public:	
 	// Called every frame
 	virtual void Tick(float DeltaTime) override;
+
+	// Soft assets the wave manager loads for this node before the first wave
+	void GetPreloadAssets(TArray<FSoftObjectPath>& OutPaths) const;
 	
 	UPROPERTY(BlueprintReadWrite, Category = "Properties")
 	bool bIsOccupied = false;
@@ -197,5 +272,9 @@ public:
 	UPROPERTY(BlueprintReadWrite, Category = "Properties")
 	bool bIsDisabled = false;
 
-	static unsigned int NumActiveNodes;
+private:
+	friend class UNPCNodeRegistry;
+	friend class USoakCommandlet;
+
+	int32 RegistrySlot = INDEX_NONE;
 };
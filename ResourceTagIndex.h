@@ -0,0 +1,83 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "GameplayFrameArena.h"
+#include "Interactables/Resources/ResourceBase.h"
+
+/**
+ * Per-tag view of an inventory's resources, built in one pass over UInventoryComponent's
+ * contents. Counts and items come back without rescanning the inventory, so checks
+ * against several tags share one pass. All storage comes from the frame arena, so an
+ * index is a local for one interaction and must not outlive the frame. The inventory
+ * keeps the items referenced for GC; an index is only valid while that inventory is
+ * unchanged, or while its owner mirrors every removal into it.
+ */
+struct FResourceTagIndex
+{
+	void Append(TConstArrayView<AResourceBase*> Items)
+	{
+		for (AResourceBase* Item : Items)
+		{
+			Add(Item);
+		}
+	}
+
+	void Add(AResourceBase* Item)
+	{
+		if (Item)
+		{
+			const FGameplayTag& Tag = Item->GetResourceTag();
+			int32 Bucket = Tags.IndexOfByKey(Tag);
+			if (Bucket == INDEX_NONE)
+			{
+				Bucket = Tags.Add(Tag);
+				Buckets.AddDefaulted();
+			}
+
+			Buckets[Bucket].Add(Item);
+			++NumItems;
+		}
+	}
+
+	bool Remove(AResourceBase* Item)
+	{
+		if (!Item)
+			return false;
+
+		const int32 Bucket = Tags.IndexOfByKey(Item->GetResourceTag());
+		if (Bucket == INDEX_NONE || Buckets[Bucket].RemoveSingleSwap(Item, false) == 0)
+			return false;
+
+		--NumItems;
+		return true;
+	}
+
+	int32 Count(const FGameplayTag& Tag) const
+	{
+		const int32 Bucket = Tags.IndexOfByKey(Tag);
+		return Bucket != INDEX_NONE ? Buckets[Bucket].Num() : 0;
+	}
+
+	// Invalidated by Add/Remove of the same tag
+	TConstArrayView<AResourceBase*> GetItems(const FGameplayTag& Tag) const
+	{
+		const int32 Bucket = Tags.IndexOfByKey(Tag);
+		return Bucket != INDEX_NONE ? TConstArrayView<AResourceBase*>(Buckets[Bucket]) : TConstArrayView<AResourceBase*>();
+	}
+
+	int32 Num() const { return NumItems; }
+
+	void Reset()
+	{
+		Tags.Reset();
+		Buckets.Reset();
+		NumItems = 0;
+	}
+
+private:
+	// An inventory holds a handful of resource types, so a scan over the tags does better than a map and stays in the arena
+	TFrameArray<FGameplayTag> Tags;
+	TFrameArray<TFrameArray<AResourceBase*>> Buckets;
+	int32 NumItems = 0;
+};
@@ -0,0 +1,415 @@
+#include "SoakCommandlet.h"
+#include "Enemies/EnemyBase.h"
+#include "Enemies/EnemyManager.h"
+#include "Enemies/EnemyProxySubsystem.h"
+#include "Enemies/WaveSpawnerManager.h"
+#include "NPCs/NPCCharacter.h"
+#include "NPCs/NPCNodeSlot.h"
+#include "GameplayFastForward.h"
+#include "Interactables/Resources/ResourceBase.h"
+#include "Engine/Engine.h"
+#include "EngineUtils.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectIterator.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogSoak, Log, All);
+
+USoakCommandlet::USoakCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = true;
+	LogToConsole = true;
+
+	HelpDescription = TEXT("Runs the wave loop headless and fails if actors, objects, memory or frame time keep growing.");
+	HelpUsage = TEXT("-run=Soak -Map=<package> [-Waves=100] [-Hours=0] [-TickRate=30] [-WarmupWaves=5] [-KillsPerSecond=2] [-Balance]");
+}
+
+int32 USoakCommandlet::Main(const FString& Params)
+{
+	if (!FParse::Value(*Params, TEXT("Map="), Settings.Map))
+	{
+		UE_LOG(LogSoak, Error, TEXT("No -Map= given. %s"), *HelpUsage);
+		return 1;
+	}
+
+	FParse::Value(*Params, TEXT("Waves="), Settings.Waves);
+	FParse::Value(*Params, TEXT("Hours="), Settings.Hours);
+	FParse::Value(*Params, TEXT("TickRate="), Settings.TickRate);
+	FParse::Value(*Params, TEXT("WarmupWaves="), Settings.WarmupWaves);
+	FParse::Value(*Params, TEXT("KillsPerSecond="), Settings.KillsPerSecond);
+	FParse::Value(*Params, TEXT("DeliveryDelay="), Settings.DeliveryDelay);
+	FParse::Value(*Params, TEXT("ReassignInterval="), Settings.ReassignInterval);
+	FParse::Value(*Params, TEXT("MaxActorsPerWave="), Settings.MaxActorsPerWave);
+	FParse::Value(*Params, TEXT("MaxObjectsPerWave="), Settings.MaxObjectsPerWave);
+	FParse::Value(*Params, TEXT("MaxMemoryMBPerWave="), Settings.MaxMemoryMBPerWave);
+	FParse::Value(*Params, TEXT("MaxFrameMsPerWave="), Settings.MaxFrameMsPerWave);
+	Settings.bBalance = FParse::Param(*Params, TEXT("Balance"));
+
+	UWorld* World = LoadWorld(Settings.Map);
+	if (!World)
+		return 1;
+
+	for (TActorIterator<ANPCNodeSlot> It(World); It; ++It)
+	{
+		Nodes.Add(*It);
+	}
+
+	FindResourceClasses(World);
+
+	const float FixedDelta = 1.0f / FMath::Max(Settings.TickRate, 1.0f);
+	const double WallStart = FPlatformTime::Seconds();
+	const double WallLimit = Settings.Hours > 0.0 ? Settings.Hours * 3600.0 : MAX_dbl;
+
+	// A wave that never ends means the loop is stuck, not that it's slow
+	const double StallSeconds = 600.0;
+
+	TArray<FSoakSample> Samples;
+	double SimSeconds = 0.0;
+	double LastWaveSimSeconds = 0.0;
+	double NextReassign = Settings.ReassignInterval;
+	double FrameMsSum = 0.0;
+	int32 FramesSinceSample = 0;
+	int32 LastWave = -1;
+	int32 Result = 0;
+
+	while (true)
+	{
+		const AWaveSpawnerManager* Manager = AWaveSpawnerManager::Get(World);
+		const int32 Wave = Manager ? Manager->GetWaveCount() : 0;
+
+		if (Wave != LastWave)
+		{
+			// Collect first so only what's really still referenced is counted
+			if (!Settings.bBalance)
+			{
+				CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+			}
+
+			const FSoakSample& Sample = Samples.Add_GetRef(TakeSample(World, Wave, SimSeconds, FramesSinceSample > 0 ? FrameMsSum / FramesSinceSample : 0.0));
+			UE_LOG(LogSoak, Display, TEXT("Wave %d at %.0fs: %d actors, %d objects, %d enemies, %.1f MB, %.3f ms/frame"),
+				Sample.Wave, Sample.SimSeconds, Sample.Actors, Sample.Objects, Sample.LiveEnemies, Sample.MemoryMB, Sample.FrameMs);
+
+			// Full and proxy tiers side by side, measured from the stand-in view since there's no player
+			if (const UEnemyProxySubsystem* Proxies = UEnemyProxySubsystem::Get(World))
+			{
+				Proxies->Report();
+			}
+
+			LastWave = Wave;
+			LastWaveSimSeconds = SimSeconds;
+			FrameMsSum = 0.0;
+			FramesSinceSample = 0;
+		}
+
+		if (Wave >= Settings.Waves || FPlatformTime::Seconds() - WallStart >= WallLimit)
+			break;
+
+		if (!Manager || SimSeconds - LastWaveSimSeconds > StallSeconds)
+		{
+			UE_LOG(LogSoak, Error, TEXT("No wave progress for %.0f simulated seconds, stopping"), SimSeconds - LastWaveSimSeconds);
+			Result = 1;
+			break;
+		}
+
+		const double FrameStart = FPlatformTime::Seconds();
+
+		UGameplayFastForwardSubsystem::StepWorld(World, FixedDelta, true);
+
+		FrameMsSum += (FPlatformTime::Seconds() - FrameStart) * 1000.0;
+		++FramesSinceSample;
+		SimSeconds += FixedDelta;
+
+		SimulateKills(World, FixedDelta);
+		SimulateDeliveries(World, SimSeconds);
+
+		if (Settings.ReassignInterval > 0.0f && SimSeconds >= NextReassign)
+		{
+			NextReassign = SimSeconds + Settings.ReassignInterval;
+			SimulateAssignments(World);
+		}
+	}
+
+	const double WallSeconds = FPlatformTime::Seconds() - WallStart;
+	UE_LOG(LogSoak, Display, TEXT("Ran %d waves, %.0f simulated seconds in %.0f seconds, %.1f simulated seconds per second"),
+		LastWave, SimSeconds, WallSeconds, WallSeconds > 0.0 ? SimSeconds / WallSeconds : 0.0);
+
+	WriteCsv(Samples);
+
+	if (!Settings.bBalance && !CheckSlopes(Samples))
+	{
+		Result = 1;
+	}
+
+	UnloadWorld(World);
+	return Result;
+}
+
+UWorld* USoakCommandlet::LoadWorld(const FString& MapName)
+{
+	UPackage* Package = LoadPackage(nullptr, *MapName, LOAD_None);
+	UWorld* World = Package ? UWorld::FindWorldInPackage(Package) : nullptr;
+	if (!World)
+	{
+		UE_LOG(LogSoak, Error, TEXT("Couldn't load map %s"), *MapName);
+		return nullptr;
+	}
+
+	World->AddToRoot();
+	World->WorldType = EWorldType::Game;
+
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	World->InitWorld();
+
+	// No local player joins, so gameplay runs without a player controller or HUD
+	const FURL URL(*MapName);
+	World->SetGameMode(URL);
+	World->InitializeActorsForPlay(URL);
+	World->BeginPlay();
+
+	return World;
+}
+
+void USoakCommandlet::UnloadWorld(UWorld* World)
+{
+	World->BeginTearingDown();
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	World->RemoveFromRoot();
+
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+}
+
+void USoakCommandlet::SimulateKills(UWorld* World, float DeltaSeconds)
+{
+	KillBudget += Settings.KillsPerSecond * DeltaSeconds;
+
+	TConstArrayView<TObjectPtr<AEnemyBase>> Enemies = AEnemyManager::GetAllEnemies(World);
+	while (KillBudget >= 1.0f && Enemies.Num() > 0)
+	{
+		KillBudget -= 1.0f;
+
+		// Goes through the batched damage path like a player hit would
+		if (AEnemyBase* Enemy = Enemies[FMath::RandRange(0, Enemies.Num() - 1)])
+		{
+			Enemy->ApplySimpleDamage(1.0e6f, nullptr);
+		}
+	}
+
+	KillBudget = FMath::Min(KillBudget, 1.0f);
+}
+
+void USoakCommandlet::FindResourceClasses(UWorld* World)
+{
+	// Whatever the map already places for a tag is what the player would carry over
+	for (TActorIterator<AResourceBase> It(World); It; ++It)
+	{
+		if (!ResourceClasses.Contains(It->GetResourceTag()))
+		{
+			ResourceClasses.Add(It->GetResourceTag(), It->GetClass());
+		}
+	}
+
+	for (TObjectIterator<UClass> It; It; ++It)
+	{
+		if (!It->IsChildOf(AResourceBase::StaticClass()) || It->HasAnyClassFlags(CLASS_Abstract | CLASS_Deprecated | CLASS_NewerVersionExists))
+			continue;
+
+		const FGameplayTag& Tag = It->GetDefaultObject<AResourceBase>()->GetResourceTag();
+		if (Tag.IsValid() && !ResourceClasses.Contains(Tag))
+		{
+			ResourceClasses.Add(Tag, *It);
+		}
+	}
+}
+
+void USoakCommandlet::SimulateDeliveries(UWorld* World, double SimSeconds)
+{
+	for (const TWeakObjectPtr<ANPCNodeSlot>& NodePtr : Nodes)
+	{
+		ANPCNodeSlot* Node = NodePtr.Get();
+		if (!Node || !Node->bIsHazardActive || Node->Hazard.CurrentQuantityNeeded <= 0)
+		{
+			HazardSeenAt.Remove(NodePtr);
+			continue;
+		}
+
+		// The player takes a little while to bring the resources over
+		const double SeenAt = HazardSeenAt.FindOrAdd(NodePtr, SimSeconds);
+		if (SimSeconds - SeenAt < Settings.DeliveryDelay)
+			continue;
+
+		const int32 Quantity = Node->Hazard.CurrentQuantityNeeded;
+		const TSubclassOf<AResourceBase>* ResourceClass = ResourceClasses.Find(Node->Hazard.ResourceTag);
+		if (ResourceClass && *ResourceClass)
+		{
+			// Spawn and hand over real resource actors so their spawn and destroy churn is soaked too
+			FActorSpawnParameters SpawnParams;
+			SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+			for (int32 i = 0; i < Quantity; ++i)
+			{
+				if (AResourceBase* Resource = World->SpawnActor<AResourceBase>(*ResourceClass, Node->GetActorTransform(), SpawnParams))
+				{
+					Node->ConsumeResource(nullptr, Resource);
+				}
+			}
+		}
+		else
+		{
+			if (!ResourceClass)
+			{
+				UE_LOG(LogSoak, Warning, TEXT("No resource class for %s, delivering it without resource actors"), *Node->Hazard.ResourceTag.ToString());
+				ResourceClasses.Add(Node->Hazard.ResourceTag, nullptr);
+			}
+			Node->DeliveredResourceCounts.FindOrAdd(Node->Hazard.ResourceTag) += Quantity;
+		}
+
+		Node->OnResourceDelivered(Node->Hazard.ResourceTag, Quantity);
+		HazardSeenAt.Remove(NodePtr);
+	}
+}
+
+void USoakCommandlet::SimulateAssignments(UWorld* World)
+{
+	TArray<ANPCNodeSlot*, TInlineAllocator<16>> Occupied;
+	TArray<ANPCNodeSlot*, TInlineAllocator<16>> Free;
+	TSet<const ANPCCharacter*> Stationed;
+
+	for (const TWeakObjectPtr<ANPCNodeSlot>& NodePtr : Nodes)
+	{
+		ANPCNodeSlot* Node = NodePtr.Get();
+		if (!Node || Node->bIsDisabled)
+			continue;
+
+		if (Node->bIsOccupied && Node->OccupantNPC)
+		{
+			Occupied.Add(Node);
+			Stationed.Add(Node->OccupantNPC);
+		}
+		else
+		{
+			Free.Add(Node);
+		}
+	}
+
+	// Take one NPC off its node so assignment and release both keep getting exercised
+	if (Occupied.Num() > 0)
+	{
+		ANPCNodeSlot* Node = Occupied[FMath::RandRange(0, Occupied.Num() - 1)];
+		Stationed.Remove(Node->OccupantNPC);
+		Node->ReleaseOccupant(nullptr, TEXT("Soak reassignment."));
+		Node->bIsOccupied = false;
+		Node->NotifyStateChanged();
+		Free.Add(Node);
+	}
+
+	for (TActorIterator<ANPCCharacter> It(World); It && Free.Num() > 0; ++It)
+	{
+		if (Stationed.Contains(*It))
+			continue;
+
+		ANPCNodeSlot* Node = Free.Pop(false);
+		Node->AssignOccupant(*It);
+	}
+}
+
+USoakCommandlet::FSoakSample USoakCommandlet::TakeSample(UWorld* World, int32 Wave, double SimSeconds, double FrameMs) const
+{
+	FSoakSample Sample;
+	Sample.Wave = Wave;
+	Sample.SimSeconds = SimSeconds;
+	Sample.Actors = World->GetActorCount();
+	Sample.Objects = GUObjectArray.GetObjectArrayNumMinusAvailable();
+	Sample.LiveEnemies = AEnemyManager::GetAllEnemies(World).Num();
+	Sample.MemoryMB = double(FPlatformMemory::GetStats().UsedPhysical) / (1024.0 * 1024.0);
+	Sample.FrameMs = FrameMs;
+	return Sample;
+}
+
+double USoakCommandlet::SlopePerWave(const TArray<FSoakSample>& Samples, int32 FirstWave, TFunctionRef<double(const FSoakSample&)> Metric)
+{
+	// Least squares over (wave, metric)
+	double SumX = 0.0, SumY = 0.0, SumXY = 0.0, SumXX = 0.0;
+	int32 Count = 0;
+
+	for (const FSoakSample& Sample : Samples)
+	{
+		if (Sample.Wave < FirstWave)
+			continue;
+
+		const double X = Sample.Wave;
+		const double Y = Metric(Sample);
+		SumX += X;
+		SumY += Y;
+		SumXY += X * Y;
+		SumXX += X * X;
+		++Count;
+	}
+
+	const double Denominator = Count * SumXX - SumX * SumX;
+	if (Count < 3 || FMath::IsNearlyZero(Denominator))
+		return 0.0;
+
+	return (Count * SumXY - SumX * SumY) / Denominator;
+}
+
+bool USoakCommandlet::CheckSlopes(const TArray<FSoakSample>& Samples) const
+{
+	struct FMetricCheck
+	{
+		const TCHAR* Name;
+		double MaxSlope;
+		double (*Metric)(const FSoakSample&);
+	};
+
+	const FMetricCheck Checks[] =
+	{
+		// Waves get bigger on purpose, so growth that follows the live enemy count isn't counted
+		{ TEXT("Actors"), Settings.MaxActorsPerWave, [](const FSoakSample& Sample) { return double(Sample.Actors - Sample.LiveEnemies); } },
+		{ TEXT("UObjects/enemy"), Settings.MaxObjectsPerWave, [](const FSoakSample& Sample) { return double(Sample.Objects) / FMath::Max(Sample.LiveEnemies, 1); } },
+		{ TEXT("Memory MB"), Settings.MaxMemoryMBPerWave, [](const FSoakSample& Sample) { return Sample.MemoryMB; } },
+		{ TEXT("Frame ms/enemy"), Settings.MaxFrameMsPerWave, [](const FSoakSample& Sample) { return Sample.FrameMs / FMath::Max(Sample.LiveEnemies, 1); } },
+	};
+
+	bool bPassed = true;
+	for (const FMetricCheck& Check : Checks)
+	{
+		const double Slope = SlopePerWave(Samples, Settings.WarmupWaves, Check.Metric);
+		const bool bOk = Slope <= Check.MaxSlope;
+		bPassed &= bOk;
+
+		if (bOk)
+		{
+			UE_LOG(LogSoak, Display, TEXT("%-14s %+.4f per wave (max %.4f)"), Check.Name, Slope, Check.MaxSlope);
+		}
+		else
+		{
+			UE_LOG(LogSoak, Error, TEXT("%-14s %+.4f per wave, over the allowed %.4f"), Check.Name, Slope, Check.MaxSlope);
+		}
+	}
+
+	return bPassed;
+}
+
+void USoakCommandlet::WriteCsv(const TArray<FSoakSample>& Samples) const
+{
+	FString Csv = TEXT("Wave,SimSeconds,Actors,UObjects,LiveEnemies,MemoryMB,FrameMs\n");
+	for (const FSoakSample& Sample : Samples)
+	{
+		Csv += FString::Printf(TEXT("%d,%.1f,%d,%d,%d,%.2f,%.4f\n"), Sample.Wave, Sample.SimSeconds, Sample.Actors,
+			Sample.Objects, Sample.LiveEnemies, Sample.MemoryMB, Sample.FrameMs);
+	}
+
+	const FString Directory = FPaths::ProjectSavedDir() / TEXT("Soak");
+	IFileManager::Get().MakeDirectory(*Directory, true);
+
+	const FString Path = Directory / FString::Printf(TEXT("Soak_%s.csv"), *FDateTime::Now().ToString());
+	FFileHelper::SaveStringToFile(Csv, *Path);
+	UE_LOG(LogSoak, Display, TEXT("Wrote %s"), *Path);
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "GameplayTagContainer.h"
+#include "SoakCommandlet.generated.h"
+
+class ANPCNodeSlot;
+class AResourceBase;
+
+/**
+ * Loads a map and runs the wave loop headless at a fixed step for a number of waves
+ * or hours, standing in for the player with kills, resource deliveries and node
+ * reassignments. Actor count, UObject count, memory and frame time are sampled at
+ * every wave boundary and the run fails if any of them keeps growing faster than
+ * its allowed slope.
+ *
+ * UnrealEditor-Cmd ProjectSwagger.uproject -run=Soak -Map=/Game/Maps/SoakTest -Waves=200 -nullrhi
+ *
+ * With -Balance it is a headless fast forward for tuning wave difficulty, reporting
+ * simulated seconds per wall clock second.
+ */
+UCLASS()
+class PROJECTSWAGGER_API USoakCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	USoakCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	struct FSoakSample
+	{
+		int32 Wave = 0;
+		double SimSeconds = 0.0;
+		int32 Actors = 0;
+		int32 Objects = 0;
+		int32 LiveEnemies = 0;
+		double MemoryMB = 0.0;
+		double FrameMs = 0.0;
+	};
+
+	struct FSoakSettings
+	{
+		FString Map;
+		int32 Waves = 100;
+		double Hours = 0.0;
+		float TickRate = 30.0f;
+		int32 WarmupWaves = 5;
+		float KillsPerSecond = 2.0f;
+		float DeliveryDelay = 4.0f;
+		float ReassignInterval = 30.0f;
+
+		// Just run the waves as fast as possible: no per-wave GC and no slope checks
+		bool bBalance = false;
+
+		// Allowed growth per wave once warmed up. Actors leave the live enemies out and
+		// UObjects and frame time are per live enemy, so a bigger wave isn't a leak
+		double MaxActorsPerWave = 2.0;
+		double MaxObjectsPerWave = 1.0;
+		double MaxMemoryMBPerWave = 1.0;
+		double MaxFrameMsPerWave = 0.002;
+	};
+
+	UWorld* LoadWorld(const FString& MapName);
+	void UnloadWorld(UWorld* World);
+
+	void SimulateKills(UWorld* World, float DeltaSeconds);
+	void SimulateDeliveries(UWorld* World, double SimSeconds);
+	void FindResourceClasses(UWorld* World);
+	void SimulateAssignments(UWorld* World);
+
+	FSoakSample TakeSample(UWorld* World, int32 Wave, double SimSeconds, double FrameMs) const;
+
+	// Fits a line through the samples after warmup and returns the slope per wave
+	static double SlopePerWave(const TArray<FSoakSample>& Samples, int32 FirstWave, TFunctionRef<double(const FSoakSample&)> Metric);
+
+	bool CheckSlopes(const TArray<FSoakSample>& Samples) const;
+	void WriteCsv(const TArray<FSoakSample>& Samples) const;
+
+	FSoakSettings Settings;
+
+	TArray<TWeakObjectPtr<ANPCNodeSlot>> Nodes;
+	TMap<TWeakObjectPtr<ANPCNodeSlot>, double> HazardSeenAt;
+	TMap<FGameplayTag, TSubclassOf<AResourceBase>> ResourceClasses;
+	float KillBudget = 0.0f;
+};
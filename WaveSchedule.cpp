@@ -0,0 +1,133 @@
+
+#include "Enemies/WaveSchedule.h"
+
+void UWaveScheduleAsset::InitializeFrom(const FWaveSettings& InDefaultSettings, const TArray<int>& InSpawnersActivePerWave,
+	const TMap<int32, FWaveSettings>& InSpawnerOverrides)
+{
+	DefaultWaveSettings = InDefaultSettings;
+	SpawnersActivePerWave = InSpawnersActivePerWave;
+	SpawnerOverrides = InSpawnerOverrides;
+	Compile();
+}
+
+void UWaveScheduleAsset::Compile()
+{
+	Stream.Initialize(Seed != 0 ? Seed : FMath::Rand());
+
+	// Settings table: default first, then one entry per overridden spawner
+	SettingsTable.Reset();
+	SettingsTable.Add(DefaultWaveSettings);
+
+	SettingsIndexBySpawner.Init(0, NumSpawnerAreas);
+	for (const TPair<int32, FWaveSettings>& Override : SpawnerOverrides)
+	{
+		if (SettingsIndexBySpawner.IsValidIndex(Override.Key))
+		{
+			SettingsIndexBySpawner[Override.Key] = SettingsTable.Add(Override.Value);
+		}
+	}
+
+	WavePlans.Reset(CompiledWaveCount);
+	SpawnerPlans.Reset(CompiledWaveCount * NumSpawnerAreas);
+
+	for (int32 WaveIndex = 0; WaveIndex < CompiledWaveCount; ++WaveIndex)
+	{
+		CompileWave(WaveIndex);
+	}
+}
+
+const FCompiledWavePlan* UWaveScheduleAsset::GetWavePlan(int32 WaveIndex)
+{
+	if (WaveIndex < 0)
+		return nullptr;
+
+	if (SettingsTable.Num() == 0)
+	{
+		Compile();
+	}
+
+	while (WavePlans.Num() <= WaveIndex)
+	{
+		CompileWave(WavePlans.Num());
+	}
+
+	return &WavePlans[WaveIndex];
+}
+
+void UWaveScheduleAsset::CompileWave(int32 WaveIndex)
+{
+	check(WaveIndex == WavePlans.Num());
+
+	FCompiledWavePlan& Plan = WavePlans.AddDefaulted_GetRef();
+	Plan.WaveIndex = WaveIndex;
+	Plan.SpawnDelay = DefaultWaveSettings.SpawnDelay;
+	Plan.SpawnShowWarningTime = DefaultWaveSettings.SpawnShowWarningTime;
+
+	if (SpawnersActivePerWave.Num() > 0)
+	{
+		Plan.NumActiveSpawners = SpawnersActivePerWave[FMath::Min(WaveIndex, SpawnersActivePerWave.Num() - 1)];
+	}
+	else
+	{
+		Plan.NumActiveSpawners = 1;
+	}
+
+	// Activation order. At wave start the first NumActiveSpawners entries outside the player's area are used.
+	TArray<int32, TInlineAllocator<8>> Order;
+	for (int32 Index = 0; Index < NumSpawnerAreas; ++Index)
+	{
+		Order.Add(Index);
+	}
+	for (int32 Index = Order.Num() - 1; Index > 0; --Index)
+	{
+		Order.Swap(Index, Stream.RandRange(0, Index));
+	}
+
+	Plan.FirstSpawnerPlan = SpawnerPlans.Num();
+	Plan.NumSpawnerPlans = Order.Num();
+
+	for (int32 SpawnerIndex : Order)
+	{
+		FSpawnerWavePlan& SpawnerPlan = SpawnerPlans.AddDefaulted_GetRef();
+		SpawnerPlan.SpawnerIndex = SpawnerIndex;
+		SpawnerPlan.SettingsIndex = SettingsIndexBySpawner[SpawnerIndex];
+
+		const FWaveSettings& Settings = SettingsTable[SpawnerPlan.SettingsIndex];
+		SpawnerPlan.EnemyCount = Settings.BaseEnemyCount;
+		if (Settings.DifficultyIncreaseEveryXWaves > 0 && WaveIndex % Settings.DifficultyIncreaseEveryXWaves == 0)
+		{
+			SpawnerPlan.bDifficultyStep = true;
+			SpawnerPlan.EnemyCount += Settings.EnemiesToAddPerDifficultyStep;
+		}
+	}
+
+	// Any NumActiveSpawners of the first NumActiveSpawners + 1 entries can end up active
+	const int32 NumCandidates = FMath::Min(Plan.NumActiveSpawners + 1, Plan.NumSpawnerPlans);
+	int32 SmallestCandidate = TNumericLimits<int32>::Max();
+	for (int32 Index = 0; Index < NumCandidates; ++Index)
+	{
+		const int32 Count = SpawnerPlans[Plan.FirstSpawnerPlan + Index].EnemyCount;
+		Plan.MaxEnemyCount += Count;
+		SmallestCandidate = FMath::Min(SmallestCandidate, Count);
+	}
+	if (NumCandidates > Plan.NumActiveSpawners)
+	{
+		Plan.MaxEnemyCount -= SmallestCandidate;
+	}
+}
+
+void UWaveScheduleAsset::GetEnemyClassPaths(TArray<FSoftObjectPath>& OutPaths) const
+{
+	if (!DefaultWaveSettings.EnemyClass.IsNull())
+	{
+		OutPaths.AddUnique(DefaultWaveSettings.EnemyClass.ToSoftObjectPath());
+	}
+
+	for (const TPair<int32, FWaveSettings>& Override : SpawnerOverrides)
+	{
+		if (!Override.Value.EnemyClass.IsNull())
+		{
+			OutPaths.AddUnique(Override.Value.EnemyClass.ToSoftObjectPath());
+		}
+	}
+}
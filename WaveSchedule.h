@@ -0,0 +1,124 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "WaveSettings.h"
+#include "WaveSchedule.generated.h"
+
+// One spawner's share of a compiled wave.
+USTRUCT(BlueprintType)
+struct FSpawnerWavePlan
+{
+	GENERATED_BODY()
+
+	// Index into the manager's sorted spawner list (same as the area index).
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Wave")
+	int32 SpawnerIndex = INDEX_NONE;
+
+	// Index into the schedule's settings table. 0 is the default settings.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Wave")
+	int32 SettingsIndex = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Wave")
+	int32 EnemyCount = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Wave")
+	bool bDifficultyStep = false;
+};
+
+USTRUCT(BlueprintType)
+struct FCompiledWavePlan
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Wave")
+	int32 WaveIndex = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Wave")
+	int32 NumActiveSpawners = 1;
+
+	// Worst case enemy count for this wave, whichever area the player is standing in.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Wave")
+	int32 MaxEnemyCount = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Wave")
+	float SpawnDelay = 5.0f;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Wave")
+	float SpawnShowWarningTime = 3.0f;
+
+	// Range into the schedule's flat spawner plan array, in activation order.
+	int32 FirstSpawnerPlan = 0;
+	int32 NumSpawnerPlans = 0;
+};
+
+/**
+ * Authored wave progression, compiled into a flat per-wave plan so the manager can
+ * look ahead instead of deciding everything when the wave starts. The manager
+ * compiles a runtime copy; the authored asset itself is never compiled, so its
+ * plans and random stream don't carry over between play sessions.
+ */
+UCLASS(BlueprintType)
+class PROJECTSWAGGER_API UWaveScheduleAsset : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	// Used by the manager to build a schedule from its own settings when no asset is assigned.
+	void InitializeFrom(const FWaveSettings& InDefaultSettings, const TArray<int>& InSpawnersActivePerWave,
+		const TMap<int32, FWaveSettings>& InSpawnerOverrides);
+
+	void Compile();
+
+	// Compiles further waves on demand. Returned pointer is valid until the next call.
+	const FCompiledWavePlan* GetWavePlan(int32 WaveIndex);
+
+	TConstArrayView<FSpawnerWavePlan> GetSpawnerPlans(const FCompiledWavePlan& Plan) const
+	{
+		return TConstArrayView<FSpawnerWavePlan>(SpawnerPlans.GetData() + Plan.FirstSpawnerPlan, Plan.NumSpawnerPlans);
+	}
+
+	const FWaveSettings& GetSettings(int32 SettingsIndex) const
+	{
+		return SettingsTable.IsValidIndex(SettingsIndex) ? SettingsTable[SettingsIndex] : DefaultWaveSettings;
+	}
+
+	int32 GetNumCompiledWaves() const { return WavePlans.Num(); }
+
+	// Every enemy class the schedule can spawn, default settings and overrides
+	void GetEnemyClassPaths(TArray<FSoftObjectPath>& OutPaths) const;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Waves")
+	FWaveSettings DefaultWaveSettings;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Waves")
+	TArray<int> SpawnersActivePerWave;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Waves", meta=(ToolTip="Per-spawner settings, keyed by spawner index. Replaces the spawner actor's own override."))
+	TMap<int32, FWaveSettings> SpawnerOverrides;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Waves", meta=(ClampMin=1))
+	int32 NumSpawnerAreas = 8;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Waves", meta=(ClampMin=1, ToolTip="Waves compiled up front. Later waves are compiled on demand."))
+	int32 CompiledWaveCount = 50;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Waves", meta=(ToolTip="Seed for spawner activation order. 0 picks a new seed every load."))
+	int32 Seed = 0;
+
+private:
+	void CompileWave(int32 WaveIndex);
+
+	UPROPERTY(Transient)
+	TArray<FWaveSettings> SettingsTable;
+
+	UPROPERTY(Transient)
+	TArray<FCompiledWavePlan> WavePlans;
+
+	UPROPERTY(Transient)
+	TArray<FSpawnerWavePlan> SpawnerPlans;
+
+	TArray<int32> SettingsIndexBySpawner;
+
+	FRandomStream Stream;
+};
@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "AkGameplayTypes.h"
+#include "UObject/SoftObjectPtr.h"
 #include "WaveSettings.generated.h"
 
 USTRUCT(BlueprintType)
@@ -9,8 +10,8 @@ struct FWaveSettings
 {
 	GENERATED_BODY()
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wave", meta=(ToolTip="Type of enemy that will spawn from this spawner."))
-	TSubclassOf<class AEnemyBase> EnemyClass;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wave", meta=(ToolTip="Type of enemy that will spawn from this spawner. Loaded in the background before the first wave."))
+	TSoftClassPtr<class AEnemyBase> EnemyClass;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wave", meta=(ToolTip="Starting number of enemies in each wave."))
 	int32 BaseEnemyCount = 5;
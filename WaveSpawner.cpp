@@ -5,8 +5,13 @@
 #include "Enemies/EnemyBase.h"
 #include "Enemies/EnemyManager.h"
 #include "Enemies/WaveSpawnerManager.h"
+#include "Enemies/CombatFeedbackManager.h"
 #include "AkGameplayStatics.h"
-#include "GameEvents.h"
+#include "GameplayEventBus.h"
+#include "GameplayActorRegistry.h"
+#include "GameplayHitchMonitor.h"
+#include "GameplayMemoryTags.h"
+#include "GameplaySnapshot.h"
 #include "TimerManager.h"
 #include "UI/ProjectSwaggerHUD.h"
 
@@ -20,13 +25,29 @@ AWaveSpawner::AWaveSpawner()
 void AWaveSpawner::BeginPlay()
 {
 	Super::BeginPlay();
+
+	if (UGameplayActorRegistry* ActorRegistry = UGameplayActorRegistry::Get(GetWorld()))
+	{
+		ActorRegistry->RegisterSpawner(this);
+	}
+}
+
+void AWaveSpawner::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UGameplayActorRegistry* ActorRegistry = UGameplayActorRegistry::Get(GetWorld()))
+	{
+		ActorRegistry->UnregisterSpawner(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void AWaveSpawner::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 	
-	if (AProjectSwaggerHUD* GameHUD = Cast<AProjectSwaggerHUD>(GetWorld()->GetFirstPlayerController()->GetHUD()))
+	const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	if (AProjectSwaggerHUD* GameHUD = PlayerController ? Cast<AProjectSwaggerHUD>(PlayerController->GetHUD()) : nullptr)
 	{
 		if (GameHUD->IsInUI())
 		{
@@ -48,43 +69,113 @@ void AWaveSpawner::Tick(float DeltaTime)
 }
 
 
-void AWaveSpawner::SpawnWave(int32 WaveCount, const FWaveSettings& ManagerSettings)
+void AWaveSpawner::SpawnWave(const FWaveSettings& Settings, int32 EnemyCount, bool bDifficultyStep)
 {
-	EffectiveSettings = bUseSpawnerOverride ? SpawnerOverrideSettings : ManagerSettings;
+	GAMEPLAY_HITCH_SCOPE(GetWorld(), "SpawnWave");
+	LLM_SCOPE_BYTAG(Swagger_Waves);
+
+	EffectiveSettings = Settings;
+
+	EnemiesToSpawn = EnemyCount;
+	if (bDifficultyStep)
+	{
+		if (UGameplayEventBus* EventBus = UGameplayEventBus::Get(GetWorld()))
+		{
+			const AWaveSpawnerManager* Manager = AWaveSpawnerManager::Get(GetWorld());
+			EventBus->Publish(FDifficultyIncreasedEvent{ this, Manager ? Manager->GetWaveCount() : 0 });
+		}
+	}
 
-	EnemiesToSpawn = EffectiveSettings.BaseEnemyCount;
-	if (WaveCount % EffectiveSettings.DifficultyIncreaseEveryXWaves == 0)
+	if (ACombatFeedbackManager* Feedback = ACombatFeedbackManager::Get(GetWorld()))
+	{
+		Feedback->PostWaveSpawnAudio(EffectiveSettings.WaveSpawnAudioEvent, this);
+	}
+	else
 	{
-		UGameEvents::OnDifficultyIncreasing.Broadcast();
-		EnemiesToSpawn += EffectiveSettings.EnemiesToAddPerDifficultyStep;
+		UAkGameplayStatics::PostEvent(EffectiveSettings.WaveSpawnAudioEvent, this, false, FOnAkPostEventCallback(), false);
 	}
 
-	UAkGameplayStatics::PostEvent(EffectiveSettings.WaveSpawnAudioEvent, this, false, FOnAkPostEventCallback(), false);
+	// Governor slows spawning down when the game thread is over budget
+	float SpawnInterval = EffectiveSettings.TimeBetweenEnemies;
+	if (const AWaveSpawnerManager* Manager = AWaveSpawnerManager::Get(GetWorld()))
+	{
+		SpawnInterval /= FMath::Max(Manager->GetSpawnRateMultiplier(), KINDA_SMALL_NUMBER);
+	}
 
 	EnemiesSpawned = 0;
-	GetWorldTimerManager().SetTimer(SpawnTimerHandle, this, &AWaveSpawner::SpawnEnemy, EffectiveSettings.TimeBetweenEnemies, true);
+	GetWorldTimerManager().SetTimer(SpawnTimerHandle, this, &AWaveSpawner::SpawnEnemy, SpawnInterval, true);
+}
+
+void AWaveSpawner::SaveState(FWaveSpawnerStateRecord& OutRecord) const
+{
+	OutRecord.Name = GetFName();
+	OutRecord.EnemiesToSpawn = EnemiesToSpawn;
+	OutRecord.EnemiesSpawned = EnemiesSpawned;
+	OutRecord.EnemyClassPath = EffectiveSettings.EnemyClass.ToSoftObjectPath().ToString();
+	OutRecord.SpawnRadius = EffectiveSettings.SpawnRadius;
+	OutRecord.SpawnInterval = GetWorldTimerManager().GetTimerRate(SpawnTimerHandle);
+	OutRecord.SpawnTimerRemaining = GetWorldTimerManager().GetTimerRemaining(SpawnTimerHandle);
+}
+
+void AWaveSpawner::RestoreState(const FWaveSpawnerStateRecord& Record)
+{
+	EnemiesToSpawn = Record.EnemiesToSpawn;
+	EnemiesSpawned = Record.EnemiesSpawned;
+	EffectiveSettings.EnemyClass = TSoftClassPtr<AEnemyBase>(FSoftObjectPath(Record.EnemyClassPath));
+	EffectiveSettings.SpawnRadius = Record.SpawnRadius;
+
+	GetWorldTimerManager().ClearTimer(SpawnTimerHandle);
+	if (Record.SpawnTimerRemaining > 0.f && Record.SpawnInterval > 0.f)
+	{
+		GetWorldTimerManager().SetTimer(SpawnTimerHandle, this, &AWaveSpawner::SpawnEnemy, Record.SpawnInterval, true, Record.SpawnTimerRemaining);
+	}
 }
 
 void AWaveSpawner::SpawnEnemy()
 {
+	GAMEPLAY_HITCH_SCOPE(GetWorld(), "SpawnEnemy");
+
 	if (EnemiesSpawned >= EnemiesToSpawn)
 	{
 		GetWorldTimerManager().ClearTimer(SpawnTimerHandle);
 		return;
 	}
 
-	FVector2D Random2D = FMath::RandPointInCircle(EffectiveSettings.SpawnRadius);
+	// Preloaded by the manager before the first wave. Settings changed at runtime or restored from a snapshot may not be.
+	TSubclassOf<AEnemyBase> EnemyClass = EffectiveSettings.EnemyClass.Get();
+	if (!EnemyClass && !EffectiveSettings.EnemyClass.IsNull())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s: enemy class %s was not preloaded, loading it now"), *GetName(), *EffectiveSettings.EnemyClass.ToString());
+		EnemyClass = EffectiveSettings.EnemyClass.LoadSynchronous();
+	}
+
+	// Over the live enemy cap the spawn goes to the manager's backlog instead of being dropped
+	AWaveSpawnerManager* Manager = AWaveSpawnerManager::Get(GetWorld());
+	if (!Manager || Manager->RequestEnemySpawn(this, EnemyClass, EffectiveSettings.SpawnRadius))
+	{
+		SpawnEnemyOfClass(EnemyClass, EffectiveSettings.SpawnRadius);
+	}
+
+	EnemiesSpawned++;
+}
+
+AEnemyBase* AWaveSpawner::SpawnEnemyOfClass(TSubclassOf<AEnemyBase> EnemyClass, float SpawnRadius)
+{
+	FVector2D Random2D = FMath::RandPointInCircle(SpawnRadius);
 	FVector SpawnLocation = FVector(GetActorLocation().X + Random2D.X, GetActorLocation().Y + Random2D.Y, GetActorLocation().Z);
 
-	FActorSpawnParameters SpawnParams;
-	
+	LLM_SCOPE_BYTAG(Swagger_Enemies);
 
-	if (AEnemyBase* SpawnedEnemy = GetWorld()->SpawnActor<AEnemyBase>(EffectiveSettings.EnemyClass, SpawnLocation, FRotator::ZeroRotator, SpawnParams))
+	// Deferred so the parent spawner is known in BeginPlay, where the enemy picks its wall
+	AEnemyBase* SpawnedEnemy = GetWorld()->SpawnActorDeferred<AEnemyBase>(EnemyClass, FTransform(SpawnLocation));
+	if (SpawnedEnemy)
 	{
+		SpawnedEnemy->SetParentSpawner(this);
+		SpawnedEnemy->FinishSpawning(FTransform(SpawnLocation));
+
 		if (AEnemyManager* EnemyMgr = AEnemyManager::Get(GetWorld()))
 			AEnemyManager::RegisterEnemy(SpawnedEnemy);
-		SpawnedEnemy->SetParentSpawner(this);
 	}
 
-	EnemiesSpawned++;
+	return SpawnedEnemy;
 }
\ No newline at end of file
@@ -6,6 +6,9 @@
 #include "WaveSettings.h"
 #include "WaveSpawner.generated.h"
 
+class AEnemyBase;
+struct FWaveSpawnerStateRecord;
+
 UCLASS()
 class PROJECTSWAGGER_API AWaveSpawner : public AActor
 {
@@ -15,9 +18,18 @@ public:
 	AWaveSpawner();
 
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void Tick(float DeltaTime) override;
 
-	void SpawnWave(int32 WaveCount, const FWaveSettings& ManagerSettings);
+	void SpawnWave(const FWaveSettings& Settings, int32 EnemyCount, bool bDifficultyStep);
+
+	AEnemyBase* SpawnEnemyOfClass(TSubclassOf<AEnemyBase> EnemyClass, float SpawnRadius);
+
+	// Settings this spawner overrides the manager defaults with, if any
+	const FWaveSettings* GetOverrideSettings() const { return bUseSpawnerOverride ? &SpawnerOverrideSettings : nullptr; }
+
+	void SaveState(FWaveSpawnerStateRecord& OutRecord) const;
+	void RestoreState(const FWaveSpawnerStateRecord& Record);
 
 private:
 	void SpawnEnemy();
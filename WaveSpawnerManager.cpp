@@ -1,31 +1,118 @@
 
 #include "Enemies/WaveSpawnerManager.h"
 #include "Enemies/WaveSpawner.h"
-#include "GameEvents.h"
-#include "Algo/RandomShuffle.h"
+#include "Enemies/EnemyBase.h"
+#include "Enemies/EnemyManager.h"
+#include "GameplayEventBus.h"
+#include "GameplayActorRegistry.h"
+#include "GameplaySnapshot.h"
+#include "GameplayFrameArena.h"
+#include "GameplayHitchMonitor.h"
+#include "GameplayMemoryTags.h"
 #include "Interactables/Base/BPI_GateControl.h"
 #include "NPCs/NPCNodeSlot.h"
+#include "NPCs/NPCNodeRegistry.h"
 #include "ProjectSwagger/ProjectSwaggerCharacter.h"
 #include "AkAudio/Classes/AkGameplayStatics.h"
 #include "Environment/MiasmaManager.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
 #include "Kismet/GameplayStatics.h"
 #include "UI/ProjectSwaggerHUD.h"
 
 AWaveSpawnerManager* AWaveSpawnerManager::Instance = nullptr;
 
+static TAutoConsoleVariable<bool> CVarMiasmaDuringWarning(
+	TEXT("Swagger.Waves.MiasmaDuringWarning"),
+	true,
+	TEXT("Rearrange miasma for the next wave when its warning shows instead of on the wave start frame."));
+
+static uint32 GetSectorBit(int Area)
+{
+	return Area >= 0 && Area < 32 ? 1u << Area : 0u;
+}
+
 
 AWaveSpawnerManager* AWaveSpawnerManager::Get(UWorld* World)
 {
 	return Instance;
 }
 
+void AWaveSpawnerManager::LoadWaveAssets()
+{
+	// Next tick, so every spawner has begun play and registered
+	CollectSpawners();
+
+	TArray<FSoftObjectPath> ClassPaths;
+	WaveSchedule->GetEnemyClassPaths(ClassPaths);
+	if (ClassPaths.IsEmpty())
+	{
+		OnEnemyClassesLoaded();
+		return;
+	}
+
+	EnemyClassesHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(ClassPaths,
+		FStreamableDelegate::CreateUObject(this, &AWaveSpawnerManager::OnEnemyClassesLoaded));
+	if (!EnemyClassesHandle.IsValid())
+	{
+		OnEnemyClassesLoaded();
+	}
+}
+
+void AWaveSpawnerManager::OnEnemyClassesLoaded()
+{
+	// Only what the classes in this schedule use, so enemy types the map never spawns stay unloaded
+	TArray<FSoftObjectPath> AssetPaths;
+	if (EnemyClassesHandle.IsValid())
+	{
+		TArray<UObject*> LoadedClasses;
+		EnemyClassesHandle->GetLoadedAssets(LoadedClasses);
+		for (UObject* Loaded : LoadedClasses)
+		{
+			if (const UClass* EnemyClass = Cast<UClass>(Loaded))
+			{
+				if (const AEnemyBase* EnemyDefaults = Cast<AEnemyBase>(EnemyClass->GetDefaultObject()))
+				{
+					EnemyDefaults->GetPreloadAssets(AssetPaths);
+				}
+			}
+		}
+	}
+
+	// Legacy station trees go through the same gate, so no node loads one mid-wave
+	if (const UNPCNodeRegistry* NodeRegistry = UNPCNodeRegistry::Get(GetWorld()))
+	{
+		for (const ANPCNodeSlot* Node : NodeRegistry->GetNodes())
+		{
+			if (Node)
+			{
+				Node->GetPreloadAssets(AssetPaths);
+			}
+		}
+	}
+
+	if (!AssetPaths.IsEmpty())
+	{
+		EnemyAssetsHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(AssetPaths,
+			FStreamableDelegate::CreateUObject(this, &AWaveSpawnerManager::SetWaveTimer));
+		if (EnemyAssetsHandle.IsValid())
+			return;
+	}
+
+	SetWaveTimer();
+}
+
 void AWaveSpawnerManager::SetWaveTimer()
 {
+	LLM_SCOPE_BYTAG(Swagger_Waves);
+
+	const FCompiledWavePlan* Plan = WaveSchedule->GetWavePlan(CurrentWaveCount);
+
 	GetWorld()->GetTimerManager().SetTimer(
 	WaveTimerHandle,
 	this,
 	&AWaveSpawnerManager::StartNextWave,
-	DefaultWaveSettings.SpawnDelay,
+	Plan->SpawnDelay,
 	true
 	);
 
@@ -33,7 +120,7 @@ void AWaveSpawnerManager::SetWaveTimer()
 	WaveWarningTimerHandle,
 	this,
 	&AWaveSpawnerManager::ShowWarning,
-	DefaultWaveSettings.SpawnDelay - DefaultWaveSettings.SpawnShowWarningTime,
+	Plan->SpawnDelay - Plan->SpawnShowWarningTime,
 	false
 	);
 }
@@ -50,34 +137,51 @@ void AWaveSpawnerManager::BeginPlay()
 
 	Spawners.Empty();
 	
-	GetWorld()->GetTimerManager().SetTimerForNextTick(this, &AWaveSpawnerManager::SetWaveTimer);
+	GetWorld()->GetTimerManager().SetTimerForNextTick(this, &AWaveSpawnerManager::LoadWaveAssets);
 
+	if (UGameplayEventBus* EventBus = UGameplayEventBus::Get(GetWorld()))
+	{
+		EventBus->On<FEnemyAttackEvent>().AddUObject(this, &AWaveSpawnerManager::OnEnemyAttackReceived);
+		EventBus->On<FDifficultyIncreasedEvent>().AddUObject(this, &AWaveSpawnerManager::OnDifficultyIncreasing);
+	}
+}
 
-	TArray<AActor*> FoundSpawners;
-	UGameplayStatics::GetAllActorsOfClass(GetWorld(), AWaveSpawner::StaticClass(), FoundSpawners);
-	NumSpawnersInScene = FoundSpawners.Num();
+void AWaveSpawnerManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (Instance == this)
+	{
+		Instance = nullptr;
+	}
 
-	for (AActor* Actor : FoundSpawners)
+	// Stops a load still in flight from starting the waves after we're gone
+	if (EnemyClassesHandle.IsValid())
 	{
-		if (AWaveSpawner* Spawner = Cast<AWaveSpawner>(Actor))
-		{
-			RegisterSpawner(Spawner);
-		}
+		EnemyClassesHandle->CancelHandle();
+	}
+	if (EnemyAssetsHandle.IsValid())
+	{
+		EnemyAssetsHandle->CancelHandle();
 	}
 
-	Spawners.Sort([](const TWeakObjectPtr<AWaveSpawner>& a, const TWeakObjectPtr<AWaveSpawner>& b) { return a.Get()->SpawnerNumber < b.Get()->SpawnerNumber; });
+	if (UGameplayEventBus* EventBus = UGameplayEventBus::Get(GetWorld()))
+	{
+		EventBus->On<FEnemyAttackEvent>().RemoveAll(this);
+		EventBus->On<FDifficultyIncreasedEvent>().RemoveAll(this);
+	}
 
-	UGameEvents::OnEnemyAttack.AddDynamic(this, &AWaveSpawnerManager::OnEnemyAttackReceived);
-	UGameEvents::OnDifficultyIncreasing.AddDynamic(this, &AWaveSpawnerManager::OnDifficultyIncreasing);
+	Super::EndPlay(EndPlayReason);
 }
 
 void AWaveSpawnerManager::Tick(float DeltaSeconds)
 {
 	Super::Tick(DeltaSeconds);
 	
-	if (AProjectSwaggerHUD* GameHUD = Cast<AProjectSwaggerHUD>(GetWorld()->GetFirstPlayerController()->GetHUD()))
+	bool bInUI = false;
+	const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	if (AProjectSwaggerHUD* GameHUD = PlayerController ? Cast<AProjectSwaggerHUD>(PlayerController->GetHUD()) : nullptr)
 	{
-		if (GameHUD->IsInUI())
+		bInUI = GameHUD->IsInUI();
+		if (bInUI)
 		{
 			// In UI, pause timer if isn't paused
 			if (!GetWorldTimerManager().IsTimerPaused(WaveTimerHandle))
@@ -104,6 +208,140 @@ void AWaveSpawnerManager::Tick(float DeltaSeconds)
 			}
 		}
 	}
+
+	Governor.Tick(GovernorSettings, DeltaSeconds, AEnemyManager::GetAllEnemies(GetWorld()).Num());
+
+	if (!bInUI)
+	{
+		ReleaseBackloggedSpawns(DeltaSeconds);
+	}
+
+	FEnemyPopulationGovernor::PublishStats(GetPopulationStats());
+}
+
+bool AWaveSpawnerManager::RequestEnemySpawn(AWaveSpawner* Spawner, TSubclassOf<AEnemyBase> EnemyClass, float SpawnRadius)
+{
+	// Keep spawn order fair: nothing jumps ahead of the backlog
+	if (SpawnBacklogHead == SpawnBacklog.Num() && Governor.CanSpawn(GovernorSettings, AEnemyManager::GetAllEnemies(GetWorld()).Num()))
+		return true;
+
+	SpawnBacklog.Add({ Spawner, EnemyClass, SpawnRadius });
+	return false;
+}
+
+void AWaveSpawnerManager::ReleaseBackloggedSpawns(float DeltaSeconds)
+{
+	if (SpawnBacklogHead == SpawnBacklog.Num())
+	{
+		BacklogReleaseAccumulator = 0.f;
+		return;
+	}
+
+	BacklogReleaseAccumulator += DeltaSeconds * GovernorSettings.BacklogSpawnsPerSecond * Governor.GetSpawnRateMultiplier();
+
+	while (BacklogReleaseAccumulator >= 1.f && SpawnBacklogHead < SpawnBacklog.Num()
+		&& Governor.CanSpawn(GovernorSettings, AEnemyManager::GetAllEnemies(GetWorld()).Num()))
+	{
+		const FBackloggedSpawn& Pending = SpawnBacklog[SpawnBacklogHead++];
+		if (AWaveSpawner* Spawner = Pending.Spawner.Get())
+		{
+			Spawner->SpawnEnemyOfClass(Pending.EnemyClass, Pending.SpawnRadius);
+		}
+		BacklogReleaseAccumulator -= 1.f;
+	}
+
+	// Don't bank releases while capped, or they all come out in one frame once there's room
+	BacklogReleaseAccumulator = FMath::Min(BacklogReleaseAccumulator, 1.f);
+
+	if (SpawnBacklogHead == SpawnBacklog.Num())
+	{
+		SpawnBacklog.Reset();
+		SpawnBacklogHead = 0;
+	}
+}
+
+FPopulationGovernorStats AWaveSpawnerManager::GetPopulationStats() const
+{
+	FPopulationGovernorStats Stats;
+	Stats.AverageGameThreadMs = Governor.GetAverageGameThreadMs();
+	Stats.EnemyCap = GovernorSettings.bEnabled ? Governor.GetEnemyCap() : -1;
+	Stats.SpawnRateMultiplier = Governor.GetSpawnRateMultiplier();
+	Stats.LiveEnemies = AEnemyManager::GetAllEnemies(GetWorld()).Num();
+	Stats.BackloggedSpawns = SpawnBacklog.Num() - SpawnBacklogHead;
+	return Stats;
+}
+
+void AWaveSpawnerManager::SaveState(FWaveManagerStateRecord& OutRecord) const
+{
+	OutRecord.CurrentWaveCount = CurrentWaveCount;
+	OutRecord.HazardTriggerChance = HazardTriggerChance;
+	OutRecord.MaxHazardsPerAttack = MaxHazardsPerAttack;
+	OutRecord.NumSpawnersIncreasedDifficulty = NumSpawnersIncreasedDifficulty;
+	OutRecord.WaveTimerRemaining = GetWorldTimerManager().GetTimerRemaining(WaveTimerHandle);
+	OutRecord.WarningTimerRemaining = GetWorldTimerManager().GetTimerRemaining(WaveWarningTimerHandle);
+}
+
+void AWaveSpawnerManager::RestoreState(const FWaveManagerStateRecord& Record)
+{
+	CurrentWaveCount = Record.CurrentWaveCount;
+	HazardTriggerChance = Record.HazardTriggerChance;
+	MaxHazardsPerAttack = Record.MaxHazardsPerAttack;
+	NumSpawnersIncreasedDifficulty = Record.NumSpawnersIncreasedDifficulty;
+
+	SpawnBacklog.Reset();
+	SpawnBacklogHead = 0;
+	BacklogReleaseAccumulator = 0.f;
+
+	// Whatever the miasma shows now, the next wave lays it out again
+	MiasmaWave = INDEX_NONE;
+
+	FTimerManager& TimerManager = GetWorldTimerManager();
+	TimerManager.ClearTimer(WaveTimerHandle);
+	TimerManager.ClearTimer(WaveWarningTimerHandle);
+
+	const FCompiledWavePlan* Plan = WaveSchedule ? WaveSchedule->GetWavePlan(CurrentWaveCount) : nullptr;
+	if (Plan && Record.WaveTimerRemaining > 0.f)
+	{
+		TimerManager.SetTimer(WaveTimerHandle, this, &AWaveSpawnerManager::StartNextWave, Plan->SpawnDelay, true, Record.WaveTimerRemaining);
+	}
+	if (Record.WarningTimerRemaining > 0.f)
+	{
+		TimerManager.SetTimer(WaveWarningTimerHandle, this, &AWaveSpawnerManager::ShowWarning, Record.WarningTimerRemaining, false);
+	}
+}
+
+void AWaveSpawnerManager::CollectSpawners()
+{
+	// Already sorted by spawner number
+	if (const UGameplayActorRegistry* ActorRegistry = UGameplayActorRegistry::Get(GetWorld()))
+	{
+		for (AWaveSpawner* Spawner : ActorRegistry->GetSpawners())
+		{
+			RegisterSpawner(Spawner);
+		}
+	}
+	NumSpawnersInScene = Spawners.Num();
+
+	if (!WaveSchedule)
+	{
+		TMap<int32, FWaveSettings> SpawnerOverrides;
+		for (int32 Index = 0; Index < Spawners.Num(); ++Index)
+		{
+			if (const FWaveSettings* Override = Spawners[Index]->GetOverrideSettings())
+			{
+				SpawnerOverrides.Add(Index, *Override);
+			}
+		}
+
+		WaveSchedule = NewObject<UWaveScheduleAsset>(this);
+		WaveSchedule->InitializeFrom(DefaultWaveSettings, SpawnersActivePerWave, SpawnerOverrides);
+	}
+	else if (WaveSchedule->GetOuter() != this)
+	{
+		// Compile into our own copy, the authored asset is shared by every session
+		WaveSchedule = DuplicateObject<UWaveScheduleAsset>(WaveSchedule, this);
+		WaveSchedule->Compile();
+	}
 }
 
 void AWaveSpawnerManager::RegisterSpawner(AWaveSpawner* Spawner)
@@ -121,7 +359,13 @@ void AWaveSpawnerManager::RegisterSpawner(AWaveSpawner* Spawner)
 
 int AWaveSpawnerManager::GetPlayersCurrentArea()
 {
-	AActor* Player = UGameplayStatics::GetActorOfClass(GetWorld(), AProjectSwaggerCharacter::StaticClass());
+	const UGameplayActorRegistry* ActorRegistry = UGameplayActorRegistry::Get(GetWorld());
+	const AActor* Player = ActorRegistry ? ActorRegistry->GetPlayer() : nullptr;
+	if (!Player)
+	{
+		return -1;
+	}
+
 	FVector2D PlayerPosition(Player->GetActorLocation().X, Player->GetActorLocation().Y);
 	if (PlayerPosition.Length() < 1700)
 	{
@@ -147,45 +391,33 @@ void AWaveSpawnerManager::StartNextWave()
 	if (!GetWorldTimerManager().IsTimerActive(WaveTimerHandle))
 		return;
 
-	TArray<int> SpawnersToUse;
-	
-	int ActiveSpawners;
-	if (SpawnersActivePerWave.Num() > 0)
-	{
-		if (CurrentWaveCount < SpawnersActivePerWave.Num())
-		{
-			ActiveSpawners = SpawnersActivePerWave[CurrentWaveCount];
-		}
-		else
-		{
-			ActiveSpawners = SpawnersActivePerWave[SpawnersActivePerWave.Num() - 1];
-		}
-	}
-	else
-	{
-		ActiveSpawners = 1;
-	}
+	const FCompiledWavePlan Plan = *WaveSchedule->GetWavePlan(CurrentWaveCount);
+
+	GAMEPLAY_HEAP_SCOPE();
+	GAMEPLAY_HITCH_SCOPE(GetWorld(), "StartNextWave");
+	LLM_SCOPE_BYTAG(Swagger_Waves);
+
+	// Wave boundary: report what the last wave left behind before this one allocates
+	FGameplayMemoryReport::LogWave(CurrentWaveCount, AEnemyManager::GetAllEnemies(GetWorld()).Num());
 
-	TArray<int> ValidAreas = {0,1,2,3,4,5,6,7};
+	// Member so the capacity is kept between waves; RearrangeMiasma takes a plain TArray
+	TArray<int>& SpawnersToUse = SpawnersToUseScratch;
+	SpawnersToUse.Reset();
 
 	int InvalidArea = GetPlayersCurrentArea();
-	ValidAreas.RemoveSwap(InvalidArea);
-	
-	while (ActiveSpawners > SpawnersToUse.Num() && ValidAreas.Num() > 0)
-	{
-		int Index = rand() % ValidAreas.Num();
-		SpawnersToUse.Add(ValidAreas[Index]);
-		ValidAreas.RemoveAtSwap(Index);
-	}
 
-	TArray<AActor*> GateActors;
-	UGameplayStatics::GetAllActorsWithInterface(GetWorld(), UBPI_GateControl::StaticClass(), GateActors);
-	
-	for (int SpawnerNum : SpawnersToUse)
+	const UGameplayActorRegistry* ActorRegistry = UGameplayActorRegistry::Get(GetWorld());
+	TConstArrayView<TObjectPtr<AActor>> GateActors = ActorRegistry ? ActorRegistry->GetGates() : TConstArrayView<TObjectPtr<AActor>>();
+
+	TArray<const FSpawnerWavePlan*, TInlineAllocator<16>> SpawnerPlans;
+	const uint32 Sectors = SelectSpawners(Plan, InvalidArea, SpawnersToUse, &SpawnerPlans);
+
+	for (const FSpawnerWavePlan* SpawnerPlan : SpawnerPlans)
 	{
-		if (SpawnerNum <= Spawners.Num())
+		const int SpawnerNum = SpawnerPlan->SpawnerIndex;
+		if (Spawners.IsValidIndex(SpawnerNum) && Spawners[SpawnerNum].IsValid())
 		{
-			Spawners[SpawnerNum]->SpawnWave(CurrentWaveCount, DefaultWaveSettings);
+			Spawners[SpawnerNum]->SpawnWave(WaveSchedule->GetSettings(SpawnerPlan->SettingsIndex), SpawnerPlan->EnemyCount, SpawnerPlan->bDifficultyStep);
 
 			for (AActor* Gate : GateActors)
 			{
@@ -200,77 +432,144 @@ void AWaveSpawnerManager::StartNextWave()
 		}
 	}
 	
-	if (AMiasmaManager* MiasmaManager = AMiasmaManager::Get())
-	{
-		MiasmaManager->RearrangeMiasma(SpawnersToUse, InvalidArea, CurrentWaveCount);
-	}
+	// Usually already arranged when the warning showed, unless the player has moved area since
+	UpdateMiasma(Sectors, SpawnersToUse, InvalidArea, CurrentWaveCount);
 	
 	CurrentWaveCount++;
+
+	// Keep the lookahead window compiled so it's never built on a wave start frame
+	WaveSchedule->GetWavePlan(CurrentWaveCount + LookaheadWaves);
+	const FCompiledWavePlan* NextPlan = WaveSchedule->GetWavePlan(CurrentWaveCount);
+
+	if (!FMath::IsNearlyEqual(GetWorldTimerManager().GetTimerRate(WaveTimerHandle), NextPlan->SpawnDelay))
+	{
+		GetWorld()->GetTimerManager().SetTimer(
+		WaveTimerHandle,
+		this,
+		&AWaveSpawnerManager::StartNextWave,
+		NextPlan->SpawnDelay,
+		true
+		);
+	}
 	
 	// Set timer to show warning for next wave
 	GetWorld()->GetTimerManager().SetTimer(
 	WaveWarningTimerHandle,
 	this,
 	&AWaveSpawnerManager::ShowWarning,
-	DefaultWaveSettings.SpawnDelay - DefaultWaveSettings.SpawnShowWarningTime,
+	NextPlan->SpawnDelay - NextPlan->SpawnShowWarningTime,
 	false
 	);
 }
 
-
-void AWaveSpawnerManager::ShowWarning()
+void AWaveSpawnerManager::GetUpcomingWaves(int32 NumWaves, TArray<FCompiledWavePlan>& OutPlans)
 {
-	if (!GetWorldTimerManager().IsTimerActive(WaveWarningTimerHandle))
+	OutPlans.Reset(NumWaves);
+
+	// Nothing until our runtime copy exists, the authored asset is never compiled
+	if (!WaveSchedule || WaveSchedule->GetOuter() != this)
 		return;
 
-	if (AProjectSwaggerHUD* GameHUD = Cast<AProjectSwaggerHUD>(GetWorld()->GetFirstPlayerController()->GetHUD()))
+	for (int32 Offset = 0; Offset < NumWaves; ++Offset)
 	{
-		GameHUD->ShowWaveWarning(DefaultWaveSettings.SpawnShowWarningTime);
+		OutPlans.Add(*WaveSchedule->GetWavePlan(CurrentWaveCount + Offset));
 	}
 }
 
 
-void AWaveSpawnerManager::OnEnemyAttackReceived()
+void AWaveSpawnerManager::ShowWarning()
 {
-	if (FMath::FRandRange(0.f, 100.f) > HazardTriggerChance)
+	if (!GetWorldTimerManager().IsTimerActive(WaveWarningTimerHandle))
 		return;
 
-	TArray<AActor*> AllNodes;
-	UGameplayStatics::GetAllActorsOfClass(GetWorld(), ANPCNodeSlot::StaticClass(), AllNodes);
+	const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	if (AProjectSwaggerHUD* GameHUD = PlayerController ? Cast<AProjectSwaggerHUD>(PlayerController->GetHUD()) : nullptr)
+	{
+		GameHUD->ShowWaveWarning(WaveSchedule->GetWavePlan(CurrentWaveCount)->SpawnShowWarningTime);
+	}
 
-	Algo::RandomShuffle(AllNodes);
+	if (CVarMiasmaDuringWarning.GetValueOnGameThread())
+	{
+		GAMEPLAY_HITCH_SCOPE(GetWorld(), "MiasmaDuringWarning");
 
-	int HazardsTriggered = 0;
-	for (AActor* Actor : AllNodes)
+		// Guess the next wave's spawners from where the player is now
+		const int InvalidArea = GetPlayersCurrentArea();
+		const uint32 Sectors = SelectSpawners(*WaveSchedule->GetWavePlan(CurrentWaveCount), InvalidArea, SpawnersToUseScratch);
+		UpdateMiasma(Sectors, SpawnersToUseScratch, InvalidArea, CurrentWaveCount);
+	}
+}
+
+uint32 AWaveSpawnerManager::SelectSpawners(const FCompiledWavePlan& Plan, int InvalidArea, TArray<int>& OutSpawners,
+	TArray<const FSpawnerWavePlan*, TInlineAllocator<16>>* OutSpawnerPlans) const
+{
+	OutSpawners.Reset();
+	if (OutSpawnerPlans)
+	{
+		OutSpawnerPlans->Reset();
+	}
+
+	uint32 Sectors = 0;
+	for (const FSpawnerWavePlan& SpawnerPlan : WaveSchedule->GetSpawnerPlans(Plan))
 	{
-		if (HazardsTriggered >= MaxHazardsPerAttack)
+		if (OutSpawners.Num() >= Plan.NumActiveSpawners)
 			break;
 
-		if (ANPCNodeSlot* Node = Cast<ANPCNodeSlot>(Actor))
+		if (SpawnerPlan.SpawnerIndex == InvalidArea)
+			continue;
+
+		OutSpawners.Add(SpawnerPlan.SpawnerIndex);
+		Sectors |= GetSectorBit(SpawnerPlan.SpawnerIndex);
+		if (OutSpawnerPlans)
 		{
-			if (Node->bHazardScheduled)
-				continue;
+			OutSpawnerPlans->Add(&SpawnerPlan);
+		}
+	}
+	return Sectors;
+}
 
-			if (Node->bIsHazardActive)
-				continue;
-			
-			if (Node->bIsDisabled)
-				continue;
+void AWaveSpawnerManager::UpdateMiasma(uint32 Sectors, const TArray<int>& SpawnersToUse, int InvalidArea, int32 Wave)
+{
+	if (Wave == MiasmaWave && Sectors == MiasmaSectors && InvalidArea == MiasmaInvalidArea)
+		return;
 
-			if (!Node->bIsOccupied)
-				continue;
+	AMiasmaManager* MiasmaManager = AMiasmaManager::Get();
+	if (!MiasmaManager)
+		return;
 
-			FString Msg = FString::Printf(TEXT("Starting hazard timer for node!"));
-			GEngine->AddOnScreenDebugMessage(-1, 2.f, FColor::Yellow, Msg);
-			
-			Node->StartHazardTimer();
-			HazardsTriggered++;
-			
-		}
+	MiasmaManager->RearrangeMiasma(SpawnersToUse, InvalidArea, Wave);
+
+	MiasmaWave = Wave;
+	MiasmaSectors = Sectors;
+	MiasmaInvalidArea = InvalidArea;
+}
+
+
+void AWaveSpawnerManager::OnEnemyAttackReceived(const FEnemyAttackEvent& Event)
+{
+	GAMEPLAY_HEAP_SCOPE();
+	GAMEPLAY_HITCH_SCOPE(GetWorld(), "EnemyAttackHazards");
+
+	if (FMath::FRandRange(0.f, 100.f) > HazardTriggerChance)
+		return;
+
+	UNPCNodeRegistry* NodeRegistry = UNPCNodeRegistry::Get(GetWorld());
+	if (!NodeRegistry)
+		return;
+
+	// Only eligible nodes are candidates, so no per-node checks are needed here
+	TArray<ANPCNodeSlot*, TInlineAllocator<8>> HazardNodes;
+	NodeRegistry->PickHazardNodes(MaxHazardsPerAttack, HazardNodes);
+
+	for (ANPCNodeSlot* Node : HazardNodes)
+	{
+		FString Msg = FString::Printf(TEXT("Starting hazard timer for node!"));
+		GEngine->AddOnScreenDebugMessage(-1, 2.f, FColor::Yellow, Msg);
+
+		Node->StartHazardTimer();
 	}
 }
 
-void AWaveSpawnerManager::OnDifficultyIncreasing()
+void AWaveSpawnerManager::OnDifficultyIncreasing(const FDifficultyIncreasedEvent& Event)
 {
 	//only increase hazard difficulty once every spawner has increased difficulty
 	NumSpawnersIncreasedDifficulty++;
@@ -286,5 +585,8 @@ void AWaveSpawnerManager::OnDifficultyIncreasing()
 	GEngine->AddOnScreenDebugMessage(-1, 2.f, FColor::Yellow, Msg);
 
 	HazardTriggerChance = FMath::Clamp(HazardTriggerChance, 0.f, 100.f);
-	MaxHazardsPerAttack = FMath::Min(MaxHazardsPerAttack, static_cast<int>(ANPCNodeSlot::NumActiveNodes));
+	if (const UNPCNodeRegistry* NodeRegistry = UNPCNodeRegistry::Get(GetWorld()))
+	{
+		MaxHazardsPerAttack = FMath::Min(MaxHazardsPerAttack, NodeRegistry->GetNumActiveNodes());
+	}
 }
@@ -3,9 +3,16 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "WaveSettings.h"
+#include "WaveSchedule.h"
+#include "EnemyPopulationGovernor.h"
 #include "WaveSpawnerManager.generated.h"
 
 class AWaveSpawner;
+class AEnemyBase;
+struct FEnemyAttackEvent;
+struct FDifficultyIncreasedEvent;
+struct FWaveManagerStateRecord;
+struct FStreamableHandle;
 
 UCLASS()
 class PROJECTSWAGGER_API AWaveSpawnerManager : public AActor
@@ -28,15 +35,48 @@ public:
 
 	UFUNCTION(BlueprintCallable)
 	int32 GetWaveCount() const { return CurrentWaveCount; }
+
+	// Compiled plans for the next NumWaves waves, starting with the one StartNextWave will run
+	UFUNCTION(BlueprintCallable, Category = "Waves")
+	void GetUpcomingWaves(int32 NumWaves, TArray<FCompiledWavePlan>& OutPlans);
+
+	UWaveScheduleAsset* GetWaveSchedule() const { return WaveSchedule; }
+
+	// Returns true if the spawner may spawn now. Otherwise the spawn is queued and released once under the cap.
+	bool RequestEnemySpawn(AWaveSpawner* Spawner, TSubclassOf<AEnemyBase> EnemyClass, float SpawnRadius);
+
+	float GetSpawnRateMultiplier() const { return Governor.GetSpawnRateMultiplier(); }
+
+	UFUNCTION(BlueprintPure, Category = "Population Governor")
+	FPopulationGovernorStats GetPopulationStats() const;
+
+	void SaveState(FWaveManagerStateRecord& OutRecord) const;
+
+	// Drops the spawn backlog and re-arms the wave timers from the record
+	void RestoreState(const FWaveManagerStateRecord& Record);
 	
 	
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void Tick(float DeltaSeconds) override;
 
 	void SetWaveTimer();
+
+	// Readiness gate for the first wave: loads the schedule's enemy classes, then their assets, then starts the wave timers
+	void LoadWaveAssets();
+	void OnEnemyClassesLoaded();
+
+	// Pulls the sorted spawners from the actor registry and builds a schedule if none is assigned
+	void CollectSpawners();
 	
 public:
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Waves", meta=(ToolTip="Wave plan to run. If empty, one is built from the settings below and the spawners' overrides."))
+	TObjectPtr<UWaveScheduleAsset> WaveSchedule = nullptr;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Waves", meta=(ClampMin=0, ToolTip="How many upcoming waves to keep compiled for preloading and budgeting."))
+	int32 LookaheadWaves = 3;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Waves")
 	FWaveSettings DefaultWaveSettings;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Waves")
@@ -58,11 +98,12 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hazard System", meta=(ToolTip="How much more likely hazards are to occur when difficulty increases."))
 	float HazardChanceIncreaseStep = 5.0f;
 
-	UFUNCTION()
-	void OnEnemyAttackReceived();
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Population Governor")
+	FPopulationGovernorSettings GovernorSettings;
 
-	UFUNCTION()
-	void OnDifficultyIncreasing();
+	void OnEnemyAttackReceived(const FEnemyAttackEvent& Event);
+
+	void OnDifficultyIncreasing(const FDifficultyIncreasedEvent& Event);
 	
 private:
 	UPROPERTY()
@@ -74,10 +115,45 @@ private:
 	UPROPERTY()
 	int32 CurrentWaveCount = 0;
 	
+	TArray<int> SpawnersToUseScratch;
+
 	FTimerHandle WaveTimerHandle;
 	FTimerHandle WaveWarningTimerHandle;
 
+	// Held for the manager's lifetime so the loaded enemy classes and their assets stay resident
+	TSharedPtr<FStreamableHandle> EnemyClassesHandle;
+	TSharedPtr<FStreamableHandle> EnemyAssetsHandle;
+
 	int GetPlayersCurrentArea();
+
+	// Spawner areas the plan uses with the player in InvalidArea, as a sector mask. OutSpawnerPlans gets the matching plans if given.
+	uint32 SelectSpawners(const FCompiledWavePlan& Plan, int InvalidArea, TArray<int>& OutSpawners,
+		TArray<const FSpawnerWavePlan*, TInlineAllocator<16>>* OutSpawnerPlans = nullptr) const;
+
+	// One full RearrangeMiasma per wave, at the warning or else at the wave start. The wave start
+	// only skips it when the warning already arranged the same sectors and player area.
+	void UpdateMiasma(uint32 Sectors, const TArray<int>& SpawnersToUse, int InvalidArea, int32 Wave);
+
+	// Layout the miasma was last arranged for, INDEX_NONE wave if none
+	int32 MiasmaWave = INDEX_NONE;
+	uint32 MiasmaSectors = 0;
+	int MiasmaInvalidArea = INDEX_NONE;
+
+	void ReleaseBackloggedSpawns(float DeltaSeconds);
+
+	struct FBackloggedSpawn
+	{
+		TWeakObjectPtr<AWaveSpawner> Spawner;
+		TSubclassOf<AEnemyBase> EnemyClass;
+		float SpawnRadius = 0.f;
+	};
+
+	FEnemyPopulationGovernor Governor;
+
+	// FIFO, consumed from SpawnBacklogHead
+	TArray<FBackloggedSpawn> SpawnBacklog;
+	int32 SpawnBacklogHead = 0;
+	float BacklogReleaseAccumulator = 0.f;
 	
 	static AWaveSpawnerManager* Instance;
 